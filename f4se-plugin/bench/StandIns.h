@@ -0,0 +1,457 @@
+#pragma once
+#include <algorithm>
+#include <any>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stack>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include <xmmintrin.h>
+#ifdef _WIN32
+#	define NOMINMAX
+#	define WIN32_LEAN_AND_MEAN
+#	include <Windows.h>
+#else
+#	include <linux/membarrier.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
+
+//Stand-ins for the parts of CommonLibF4, PPL & the plugin that the animation math headers use, so they can be
+//built & measured outside of the game. The math follows Gamebryo's conventions, but the game's own versions
+//of these functions are what actually run in-game.
+
+namespace RE
+{
+	class NiPoint2
+	{
+	public:
+		constexpr NiPoint2() noexcept = default;
+		constexpr NiPoint2(float a_x, float a_y) noexcept :
+			x(a_x), y(a_y) {}
+
+		float x{ 0.0f };
+		float y{ 0.0f };
+	};
+
+	class NiPoint3
+	{
+	public:
+		constexpr NiPoint3() noexcept = default;
+		constexpr NiPoint3(float a_x, float a_y, float a_z) noexcept :
+			x(a_x), y(a_y), z(a_z) {}
+
+		NiPoint3 operator+(const NiPoint3& a_rhs) const { return { x + a_rhs.x, y + a_rhs.y, z + a_rhs.z }; }
+		NiPoint3 operator-(const NiPoint3& a_rhs) const { return { x - a_rhs.x, y - a_rhs.y, z - a_rhs.z }; }
+		NiPoint3 operator*(float a_scalar) const { return { x * a_scalar, y * a_scalar, z * a_scalar }; }
+		NiPoint3 operator-() const { return { -x, -y, -z }; }
+
+		float x{ 0.0f };
+		float y{ 0.0f };
+		float z{ 0.0f };
+	};
+
+	class alignas(0x10) NiPoint3A : public NiPoint3
+	{
+	public:
+		using NiPoint3::NiPoint3;
+
+		float pad{ 0.0f };
+	};
+
+	struct NiPoint4
+	{
+		float pt[4]{ 0.0f, 0.0f, 0.0f, 0.0f };
+	};
+
+	class NiMatrix3
+	{
+	public:
+		void MakeIdentity()
+		{
+			for (size_t r = 0; r < 3; r++) {
+				for (size_t c = 0; c < 4; c++) {
+					entry[r].pt[c] = r == c ? 1.0f : 0.0f;
+				}
+			}
+		}
+
+		NiMatrix3 operator*(const NiMatrix3& a_rhs) const
+		{
+			NiMatrix3 result;
+			for (size_t r = 0; r < 3; r++) {
+				for (size_t c = 0; c < 3; c++) {
+					result.entry[r].pt[c] = entry[r].pt[0] * a_rhs.entry[0].pt[c] + entry[r].pt[1] * a_rhs.entry[1].pt[c] + entry[r].pt[2] * a_rhs.entry[2].pt[c];
+				}
+			}
+			return result;
+		}
+
+		NiPoint3 operator*(const NiPoint3& a_rhs) const
+		{
+			return {
+				entry[0].pt[0] * a_rhs.x + entry[0].pt[1] * a_rhs.y + entry[0].pt[2] * a_rhs.z,
+				entry[1].pt[0] * a_rhs.x + entry[1].pt[1] * a_rhs.y + entry[1].pt[2] * a_rhs.z,
+				entry[2].pt[0] * a_rhs.x + entry[2].pt[1] * a_rhs.y + entry[2].pt[2] * a_rhs.z
+			};
+		}
+
+		//Rx * Ry * Rz
+		void FromEulerAnglesXYZ(float a_x, float a_y, float a_z)
+		{
+			const float ca = std::cos(a_x), sa = std::sin(a_x);
+			const float cb = std::cos(a_y), sb = std::sin(a_y);
+			const float cc = std::cos(a_z), sc = std::sin(a_z);
+			Set({ cb * cc, -cb * sc, sb },
+				{ ca * sc + sa * sb * cc, ca * cc - sa * sb * sc, -sa * cb },
+				{ sa * sc - ca * sb * cc, sa * cc + ca * sb * sc, ca * cb });
+		}
+
+		//Rz * Rx * Ry
+		void FromEulerAnglesZXY(float a_z, float a_x, float a_y)
+		{
+			const float ca = std::cos(a_x), sa = std::sin(a_x);
+			const float cb = std::cos(a_y), sb = std::sin(a_y);
+			const float cc = std::cos(a_z), sc = std::sin(a_z);
+			Set({ cc * cb - sc * sa * sb, -sc * ca, cc * sb + sc * sa * cb },
+				{ sc * cb + cc * sa * sb, cc * ca, sc * sb - cc * sa * cb },
+				{ -ca * sb, sa, ca * cb });
+		}
+
+		void ToEulerAnglesXYZ(float& a_x, float& a_y, float& a_z) const
+		{
+			const float s = std::clamp(entry[0].pt[2], -1.0f, 1.0f);
+			a_y = std::asin(s);
+			if (std::fabs(s) < 0.9999f) {
+				a_x = std::atan2(-entry[1].pt[2], entry[2].pt[2]);
+				a_z = std::atan2(-entry[0].pt[1], entry[0].pt[0]);
+			} else {
+				a_x = std::atan2(entry[2].pt[1], entry[1].pt[1]);
+				a_z = 0.0f;
+			}
+		}
+
+		void ToEulerAnglesZXY(float& a_z, float& a_x, float& a_y) const
+		{
+			const float s = std::clamp(entry[2].pt[1], -1.0f, 1.0f);
+			a_x = std::asin(s);
+			if (std::fabs(s) < 0.9999f) {
+				a_y = std::atan2(-entry[2].pt[0], entry[2].pt[2]);
+				a_z = std::atan2(-entry[0].pt[1], entry[1].pt[1]);
+			} else {
+				a_y = 0.0f;
+				a_z = std::atan2(entry[1].pt[0], entry[0].pt[0]);
+			}
+		}
+
+		NiPoint4 entry[3];
+
+	private:
+		void Set(const NiPoint3& a_r0, const NiPoint3& a_r1, const NiPoint3& a_r2)
+		{
+			const NiPoint3* rows[3] = { &a_r0, &a_r1, &a_r2 };
+			for (size_t r = 0; r < 3; r++) {
+				entry[r].pt[0] = rows[r]->x;
+				entry[r].pt[1] = rows[r]->y;
+				entry[r].pt[2] = rows[r]->z;
+				entry[r].pt[3] = 0.0f;
+			}
+		}
+	};
+
+	class NiQuaternion
+	{
+	public:
+		constexpr NiQuaternion() noexcept = default;
+		constexpr NiQuaternion(float a_w, float a_x, float a_y, float a_z) noexcept :
+			w(a_w), x(a_x), y(a_y), z(a_z) {}
+
+		NiQuaternion operator-() const { return { -w, -x, -y, -z }; }
+
+		void ToRotation(NiMatrix3& a_m) const
+		{
+			const float tx = x * 2.0f, ty = y * 2.0f, tz = z * 2.0f;
+			const float twx = tx * w, twy = ty * w, twz = tz * w;
+			const float txx = tx * x, txy = ty * x, txz = tz * x;
+			const float tyy = ty * y, tyz = tz * y, tzz = tz * z;
+
+			a_m.entry[0] = { { 1.0f - (tyy + tzz), txy - twz, txz + twy, 0.0f } };
+			a_m.entry[1] = { { txy + twz, 1.0f - (txx + tzz), tyz - twx, 0.0f } };
+			a_m.entry[2] = { { txz - twy, tyz + twx, 1.0f - (txx + tyy), 0.0f } };
+		}
+
+		void FromRotation(const NiMatrix3& a_m)
+		{
+			const auto& m = a_m.entry;
+			const float trace = m[0].pt[0] + m[1].pt[1] + m[2].pt[2];
+			if (trace > 0.0f) {
+				float root = std::sqrt(trace + 1.0f);
+				w = 0.5f * root;
+				root = 0.5f / root;
+				x = (m[2].pt[1] - m[1].pt[2]) * root;
+				y = (m[0].pt[2] - m[2].pt[0]) * root;
+				z = (m[1].pt[0] - m[0].pt[1]) * root;
+			} else {
+				constexpr size_t next[3] = { 1, 2, 0 };
+				size_t i = 0;
+				if (m[1].pt[1] > m[0].pt[0])
+					i = 1;
+				if (m[2].pt[2] > m[i].pt[i])
+					i = 2;
+				const size_t j = next[i];
+				const size_t k = next[j];
+
+				float root = std::sqrt(m[i].pt[i] - m[j].pt[j] - m[k].pt[k] + 1.0f);
+				float* quat[3] = { &x, &y, &z };
+				*quat[i] = 0.5f * root;
+				root = 0.5f / root;
+				w = (m[k].pt[j] - m[j].pt[k]) * root;
+				*quat[j] = (m[j].pt[i] + m[i].pt[j]) * root;
+				*quat[k] = (m[k].pt[i] + m[i].pt[k]) * root;
+			}
+		}
+
+		void FromEulerAnglesXYZ(float a_x, float a_y, float a_z)
+		{
+			NiMatrix3 m;
+			m.FromEulerAnglesXYZ(a_x, a_y, a_z);
+			FromRotation(m);
+		}
+
+		//Doesn't take the shortest path, same as the engine's.
+		void Slerp(float a_t, const NiQuaternion& a_p, const NiQuaternion& a_q)
+		{
+			const float cs = Dot(a_p, a_q);
+			const float angle = std::acos(std::clamp(cs, -1.0f, 1.0f));
+			if (std::fabs(angle) < 1e-5f) {
+				*this = a_p;
+				return;
+			}
+
+			const float invSin = 1.0f / std::sin(angle);
+			const float tAngle = a_t * angle;
+			const float c0 = std::sin(angle - tAngle) * invSin;
+			const float c1 = std::sin(tAngle) * invSin;
+			w = c0 * a_p.w + c1 * a_q.w;
+			x = c0 * a_p.x + c1 * a_q.x;
+			y = c0 * a_p.y + c1 * a_q.y;
+			z = c0 * a_p.z + c1 * a_q.z;
+		}
+
+		//Squad tangent at q1: q1 * exp(-(log(q1^-1 * q0) + log(q1^-1 * q2)) / 4)
+		void Intermediate(const NiQuaternion& a_q0, const NiQuaternion& a_q1, const NiQuaternion& a_q2)
+		{
+			const NiQuaternion inv{ a_q1.w, -a_q1.x, -a_q1.y, -a_q1.z };
+			const NiQuaternion l0 = Log(Mul(inv, a_q0));
+			const NiQuaternion l2 = Log(Mul(inv, a_q2));
+			const NiQuaternion e{ 0.0f, -0.25f * (l0.x + l2.x), -0.25f * (l0.y + l2.y), -0.25f * (l0.z + l2.z) };
+			*this = Mul(a_q1, Exp(e));
+		}
+
+		float w{ 0.0f };
+		float x{ 0.0f };
+		float y{ 0.0f };
+		float z{ 0.0f };
+
+	private:
+		static float Dot(const NiQuaternion& a_p, const NiQuaternion& a_q)
+		{
+			return a_p.w * a_q.w + a_p.x * a_q.x + a_p.y * a_q.y + a_p.z * a_q.z;
+		}
+
+		static NiQuaternion Mul(const NiQuaternion& a_p, const NiQuaternion& a_q)
+		{
+			return {
+				a_p.w * a_q.w - a_p.x * a_q.x - a_p.y * a_q.y - a_p.z * a_q.z,
+				a_p.w * a_q.x + a_p.x * a_q.w + a_p.y * a_q.z - a_p.z * a_q.y,
+				a_p.w * a_q.y + a_p.y * a_q.w + a_p.z * a_q.x - a_p.x * a_q.z,
+				a_p.w * a_q.z + a_p.z * a_q.w + a_p.x * a_q.y - a_p.y * a_q.x
+			};
+		}
+
+		static NiQuaternion Log(const NiQuaternion& a_q)
+		{
+			const float angle = std::acos(std::clamp(a_q.w, -1.0f, 1.0f));
+			const float s = std::sin(angle);
+			const float f = std::fabs(s) > 1e-5f ? angle / s : 1.0f;
+			return { 0.0f, a_q.x * f, a_q.y * f, a_q.z * f };
+		}
+
+		static NiQuaternion Exp(const NiQuaternion& a_q)
+		{
+			const float angle = std::sqrt(a_q.x * a_q.x + a_q.y * a_q.y + a_q.z * a_q.z);
+			const float f = angle > 1e-5f ? std::sin(angle) / angle : 1.0f;
+			return { std::cos(angle), a_q.x * f, a_q.y * f, a_q.z * f };
+		}
+	};
+
+	class NiTransform
+	{
+	public:
+		NiTransform() { rotate.MakeIdentity(); }
+
+		void Multiply(NiTransform& a_out, const NiTransform& a_child) const
+		{
+			a_out.rotate = rotate * a_child.rotate;
+			a_out.translate = (rotate * (a_child.translate * scale)) + translate;
+			a_out.scale = scale * a_child.scale;
+		}
+
+		NiMatrix3 rotate;
+		NiPoint3 translate;
+		float scale{ 1.0f };
+	};
+
+	class NiNode;
+
+	class NiAVObject
+	{
+	public:
+		virtual ~NiAVObject() = default;
+		virtual NiNode* IsNode() { return nullptr; }
+
+		NiNode* parent{ nullptr };
+		NiTransform local;
+		NiTransform world;
+	};
+
+	class NiNode : public NiAVObject
+	{
+	public:
+		NiNode* IsNode() override { return this; }
+
+		std::vector<NiAVObject*> children;
+	};
+
+	class Actor
+	{
+	};
+
+	//Not reference counted, only carried around in event payloads.
+	template <class T>
+	class NiPointer
+	{
+	public:
+		NiPointer() = default;
+		NiPointer(T* a_ptr) :
+			_ptr(a_ptr) {}
+
+		T* get() const { return _ptr; }
+
+	private:
+		T* _ptr = nullptr;
+	};
+}
+
+class safe_mutex : public std::recursive_mutex
+{
+};
+
+#ifndef _WIN32
+//Events.h uses Windows' process-wide write barrier. membarrier is the Linux equivalent, with a local fence
+//as a fallback for kernels that don't support it.
+inline void FlushProcessWriteBuffers()
+{
+	static const bool registered = syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+	if (!registered || syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0) != 0)
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+#endif
+
+//Runs serially, so the measured times are single-threaded.
+namespace concurrency
+{
+	template <class It, class F>
+	void parallel_for_each(It a_first, It a_last, const F& a_func)
+	{
+		std::for_each(a_first, a_last, a_func);
+	}
+
+	template <class T, class F>
+	void parallel_for(T a_first, T a_last, const F& a_func)
+	{
+		for (T i = a_first; i < a_last; i++) {
+			a_func(i);
+		}
+	}
+}
+
+namespace Serialization::General
+{
+	struct SerializableRefHandle
+	{
+	};
+}
+
+namespace Utility
+{
+	static std::vector<std::string_view> SplitString(const std::string_view& fullString, const std::string_view& delimiter)
+	{
+		std::vector<std::string_view> substrings;
+		size_t start = 0;
+		size_t end = fullString.find(delimiter);
+
+		while (end != std::string::npos) {
+			substrings.push_back(fullString.substr(start, end - start));
+			start = end + delimiter.length();
+			end = fullString.find(delimiter, start);
+		}
+
+		if (start < fullString.length()) {
+			substrings.push_back(fullString.substr(start));
+		}
+		return substrings;
+	}
+
+	static float StringToFloat(const std::string_view& str)
+	{
+		try {
+			return std::stof(std::string(str));
+		} catch (...) {
+			return 0.0f;
+		}
+	}
+}
+
+namespace Data::Settings
+{
+	class ThreadSafeString
+	{
+	public:
+		ThreadSafeString(const char* s) :
+			_data(s) {}
+
+		std::string get()
+		{
+			std::unique_lock l{ lock };
+			return _data;
+		}
+
+	private:
+		std::mutex lock;
+		std::string _data;
+	};
+
+	struct SettingValues
+	{
+		std::atomic<bool> bReduceAnimationKeys = false;
+		std::atomic<float> fKeyReductionPosTolerance = 0.05f;
+		std::atomic<float> fKeyReductionRotTolerance = 0.2f;
+		ThreadSafeString sKeyReductionNodeTolerances = "";
+	};
+
+	inline SettingValues Values;
+}
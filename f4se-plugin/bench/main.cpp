@@ -0,0 +1,931 @@
+//Micro-benchmarks for the animation interpolation & sampling kernels. Each kernel is timed on generated keys,
+//its heap allocations are counted, and its output is compared against a reference implementation in double precision
+//(or against the per-sample path it replaces, for the batched ones).
+//
+//The event bus is measured the same way against a copy of the std::any bus it replaced. Its error column is
+//the difference between the payloads delivered and the payloads sent.
+//
+//Usage: NAFBench [min milliseconds per kernel, default 200]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#include "StandIns.h"
+#include "BodyAnimation/Spline.h"
+#include "Misc/Easing.h"
+#include "Misc/MathUtil.h"
+#include "BodyAnimation/NodeAnimationData.h"
+#include "Data/Events.h"
+
+using BodyAnimation::NodeTransform;
+
+namespace
+{
+	std::atomic<uint64_t> allocCount = 0;
+}
+
+//Counts allocations for the allocs/sample column. GCC sees these replacements being inlined into the new/delete pairs
+//at each call site, and since it can't tell that they're the replacement for each other, it flags the free as mismatched.
+#if defined(__GNUC__) && !defined(__clang__)
+#	pragma GCC diagnostic push
+#	pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size)
+{
+	allocCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size > 0 ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#	pragma GCC diagnostic pop
+#endif
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	std::chrono::milliseconds minDuration{ 200 };
+	volatile float sink = 0.0f;
+
+	//Double precision math for the references.
+
+	struct DPt3
+	{
+		double x = 0.0, y = 0.0, z = 0.0;
+	};
+
+	struct DQuat
+	{
+		double w = 1.0, x = 0.0, y = 0.0, z = 0.0;
+
+		DQuat operator*(double s) const { return { w * s, x * s, y * s, z * s }; }
+		DQuat operator+(const DQuat& q) const { return { w + q.w, x + q.x, y + q.y, z + q.z }; }
+		DQuat operator-() const { return { -w, -x, -y, -z }; }
+	};
+
+	DPt3 ToD(const RE::NiPoint3& p) { return { p.x, p.y, p.z }; }
+	DQuat ToD(const RE::NiQuaternion& q) { return { q.w, q.x, q.y, q.z }; }
+	double Dot(const DQuat& a, const DQuat& b) { return a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z; }
+
+	DQuat Normalize(const DQuat& q)
+	{
+		const double len = std::sqrt(Dot(q, q));
+		return len > 0.0 ? q * (1.0 / len) : q;
+	}
+
+	DQuat Mul(const DQuat& p, const DQuat& q)
+	{
+		return {
+			p.w * q.w - p.x * q.x - p.y * q.y - p.z * q.z,
+			p.w * q.x + p.x * q.w + p.y * q.z - p.z * q.y,
+			p.w * q.y + p.y * q.w + p.z * q.x - p.x * q.z,
+			p.w * q.z + p.z * q.w + p.x * q.y - p.y * q.x
+		};
+	}
+
+	DQuat Conjugate(const DQuat& q) { return { q.w, -q.x, -q.y, -q.z }; }
+
+	DQuat Log(const DQuat& q)
+	{
+		const double angle = std::acos(std::clamp(q.w, -1.0, 1.0));
+		const double s = std::sin(angle);
+		const double f = std::fabs(s) > 1e-12 ? angle / s : 1.0;
+		return { 0.0, q.x * f, q.y * f, q.z * f };
+	}
+
+	DQuat Exp(const DQuat& q)
+	{
+		const double angle = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
+		const double f = angle > 1e-12 ? std::sin(angle) / angle : 1.0;
+		return { std::cos(angle), q.x * f, q.y * f, q.z * f };
+	}
+
+	DPt3 Lerp(const DPt3& a, const DPt3& b, double t)
+	{
+		return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t };
+	}
+
+	//Without the shortest path adjustment, like NiQuaternion::Slerp.
+	DQuat Slerp(double t, const DQuat& p, const DQuat& q)
+	{
+		const double angle = std::acos(std::clamp(Dot(p, q), -1.0, 1.0));
+		if (std::fabs(angle) < 1e-5)
+			return p;
+
+		const double invSin = 1.0 / std::sin(angle);
+		return p * (std::sin(angle - t * angle) * invSin) + q * (std::sin(t * angle) * invSin);
+	}
+
+	DQuat ShortestPathSlerp(double t, const DQuat& p, const DQuat& q)
+	{
+		return Slerp(t, p, Dot(p, q) < 0.0 ? -q : q);
+	}
+
+	DQuat Intermediate(const DQuat& q0, const DQuat& q1, const DQuat& q2)
+	{
+		const DQuat inv = Conjugate(q1);
+		const DQuat l0 = Log(Mul(inv, q0));
+		const DQuat l2 = Log(Mul(inv, q2));
+		return Mul(q1, Exp((l0 + l2) * -0.25));
+	}
+
+	//dh's scaled angle-axis helpers, which use a scale of 5 rather than 2.
+	DPt3 ToScaledAngleAxis(const DQuat& q)
+	{
+		if (q.w >= 1.0)
+			return {};
+
+		const double length = std::sqrt(1.0 - q.w * q.w);
+		const double f = 5.0 * std::acos(std::clamp(q.w, -1.0, 1.0)) / length;
+		return { q.x * f, q.y * f, q.z * f };
+	}
+
+	DQuat FromScaledAngleAxis(const DPt3& v)
+	{
+		const DQuat half{ 0.0, v.x / 5.0, v.y / 5.0, v.z / 5.0 };
+		return Exp(half);
+	}
+
+	DQuat Abs(const DQuat& q) { return q.w < 0.0 ? -q : q; }
+
+	DPt3 HermiteDelta(const DQuat& r1, const DQuat& r0)
+	{
+		return ToScaledAngleAxis(Abs(Mul(r1, { -r0.w, r0.x, r0.y, r0.z })));
+	}
+
+	DQuat QuatHermite(double t, const DQuat& r0, const DQuat& r1, const DPt3& v0, const DPt3& v1)
+	{
+		const double w1 = 3 * t * t - 2 * t * t * t;
+		const double w2 = t * t * t - 2 * t * t + t;
+		const double w3 = t * t * t - t * t;
+		const DPt3 d = HermiteDelta(r1, r0);
+		const DPt3 v{ w1 * d.x + w2 * v0.x + w3 * v1.x, w1 * d.y + w2 * v0.y + w3 * v1.y, w1 * d.z + w2 * v0.z + w3 * v1.z };
+		return Normalize(Mul(FromScaledAngleAxis(v), r0));
+	}
+
+	double Error(const RE::NiPoint3& a, const DPt3& b)
+	{
+		return std::max({ std::fabs(a.x - b.x), std::fabs(a.y - b.y), std::fabs(a.z - b.z) });
+	}
+
+	//Angle between the two rotations, in radians.
+	double Error(const RE::NiQuaternion& a, const DQuat& b)
+	{
+		const double dot = std::fabs(Dot(Normalize(ToD(a)), Normalize(b)));
+		return 2.0 * std::acos(std::min(dot, 1.0));
+	}
+
+	double Error(const NodeTransform& a, const NodeTransform& b)
+	{
+		return std::max(Error(a.translate, ToD(b.translate)), Error(a.rotate, ToD(b.rotate)));
+	}
+
+	//Test data.
+
+	struct Keys
+	{
+		std::vector<float> X;
+		std::vector<RE::NiPoint3> Yp;
+		std::vector<RE::NiQuaternion> Yr;
+	};
+
+	RE::NiQuaternion RandomStep(std::mt19937& rng, const RE::NiQuaternion& from, float maxAngle)
+	{
+		std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> angle(0.0f, maxAngle);
+		DPt3 a{ axis(rng), axis(rng), axis(rng) };
+		const double len = std::max(std::sqrt(a.x * a.x + a.y * a.y + a.z * a.z), 1e-6);
+		const double half = angle(rng) * 0.5;
+		const double s = std::sin(half) / len;
+		const DQuat q = Normalize(Mul(ToD(from), { std::cos(half), a.x * s, a.y * s, a.z * s }));
+		return { static_cast<float>(q.w), static_cast<float>(q.x), static_cast<float>(q.y), static_cast<float>(q.z) };
+	}
+
+	//Unevenly spaced keys between 0 & duration, with positions & rotations taking a random walk.
+	Keys MakeKeys(size_t count, float duration, uint32_t seed)
+	{
+		std::mt19937 rng{ seed };
+		std::uniform_real_distribution<float> jitter(-0.3f, 0.3f);
+		std::uniform_real_distribution<float> step(-2.0f, 2.0f);
+
+		Keys result;
+		RE::NiPoint3 pos;
+		RE::NiQuaternion rot{ 1.0f, 0.0f, 0.0f, 0.0f };
+		const float spacing = duration / static_cast<float>(count - 1);
+		for (size_t i = 0; i < count; i++) {
+			float t = static_cast<float>(i) * spacing;
+			if (i > 0 && i + 1 < count)
+				t += jitter(rng) * spacing;
+			result.X.push_back(t);
+			result.Yp.push_back(pos);
+			result.Yr.push_back(rot);
+			pos = pos + RE::NiPoint3{ step(rng), step(rng), step(rng) };
+			rot = RandomStep(rng, rot, 1.2f);
+		}
+		return result;
+	}
+
+	std::vector<float> MakeTimes(float begin, float end, size_t count)
+	{
+		std::vector<float> result(count);
+		for (size_t i = 0; i < count; i++) {
+			result[i] = begin + (end - begin) * static_cast<float>(i) / static_cast<float>(count - 1);
+		}
+		return result;
+	}
+
+	//Timing & reporting.
+
+	struct Measurement
+	{
+		double nsPerSample = 0.0;
+		double allocsPerSample = 0.0;
+	};
+
+	template <class F>
+	Measurement Measure(size_t samplesPerCall, F&& func)
+	{
+		func();
+
+		size_t calls = 0;
+		const uint64_t allocsBefore = allocCount.load();
+		const auto start = Clock::now();
+		auto elapsed = Clock::duration::zero();
+		do {
+			func();
+			calls++;
+			elapsed = Clock::now() - start;
+		} while (elapsed < minDuration);
+		const uint64_t allocs = allocCount.load() - allocsBefore;
+
+		const double samples = static_cast<double>(calls) * static_cast<double>(samplesPerCall);
+		return {
+			static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / samples,
+			static_cast<double>(allocs) / samples
+		};
+	}
+
+	void Report(const char* name, const Measurement& m, double maxError, const char* reference)
+	{
+		std::printf("%-54s %10.2f %10.3f %12.3e  %s\n", name, m.nsPerSample, m.allocsPerSample, maxError, reference);
+	}
+
+	template <class T, class D>
+	double MaxError(const std::vector<T>& out, const std::vector<D>& ref)
+	{
+		double result = 0.0;
+		for (size_t i = 0; i < out.size(); i++) {
+			result = std::max(result, Error(out[i], ref[i]));
+		}
+		return result;
+	}
+
+	//Kernels.
+
+	void BenchNodeTransformLerp()
+	{
+		const auto keys = MakeKeys(4096, 100.0f, 1);
+		std::mt19937 rng{ 2 };
+		std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+		std::vector<NodeTransform> begin, end, out(keys.X.size() - 1);
+		std::vector<float> t;
+		for (size_t i = 0; i + 1 < keys.X.size(); i++) {
+			begin.emplace_back(keys.Yr[i], keys.Yp[i]);
+			//Every other pair is in opposite hemispheres, to exercise the shortest path flip.
+			end.emplace_back(i % 2 ? -keys.Yr[i + 1] : keys.Yr[i + 1], keys.Yp[i + 1]);
+			t.push_back(dist(rng));
+		}
+
+		auto m = Measure(out.size(), [&]() {
+			for (size_t i = 0; i < out.size(); i++) {
+				out[i].Lerp(begin[i], end[i], t[i]);
+			}
+			sink = out.back().translate.x;
+		});
+
+		double err = 0.0;
+		for (size_t i = 0; i < out.size(); i++) {
+			const DPt3 p = Lerp(ToD(begin[i].translate), ToD(end[i].translate), t[i]);
+			const DQuat q = ShortestPathSlerp(t[i], ToD(begin[i].rotate), ToD(end[i].rotate));
+			err = std::max({ err, Error(out[i].translate, p), Error(out[i].rotate, q) });
+		}
+		Report("NodeTransform::Lerp", m, err, "double lerp & shortest path slerp");
+	}
+
+	BodyAnimation::NodeTimeline MakeTimeline(const Keys& keys)
+	{
+		BodyAnimation::NodeTimeline tl;
+		for (size_t i = 0; i < keys.X.size(); i++) {
+			tl.keys[keys.X[i]].value = NodeTransform{ keys.Yr[i], keys.Yp[i] };
+		}
+		tl.Init();
+		return tl;
+	}
+
+	void BenchNodeTimeline(bool quantized)
+	{
+		const auto keys = MakeKeys(64, 4.0f, 3);
+		auto tl = MakeTimeline(keys);
+		if (quantized && !tl.Compress()) {
+			std::printf("NodeTimeline::Compress failed, skipping the quantized timeline.\n");
+			return;
+		}
+
+		//3 loops of 60fps playback, so the cached segment is invalidated on every loop.
+		auto loop = MakeTimes(0.0f, 4.0f, 241);
+		std::vector<float> times;
+		for (size_t i = 0; i < 3; i++) {
+			times.insert(times.end(), loop.begin(), loop.end());
+		}
+		std::vector<NodeTransform> out(times.size());
+
+		auto m = Measure(times.size(), [&]() {
+			for (size_t i = 0; i < times.size(); i++) {
+				tl.GetValueAtTime(times[i], out[i]);
+			}
+			sink = out.back().translate.x;
+		});
+
+		double err = 0.0;
+		for (size_t i = 0; i < times.size(); i++) {
+			const float t = times[i];
+			const size_t next = std::clamp(static_cast<size_t>(std::upper_bound(keys.X.begin(), keys.X.end(), t) - keys.X.begin()), static_cast<size_t>(1), keys.X.size() - 1);
+			const double f = std::clamp((static_cast<double>(t) - keys.X[next - 1]) / (static_cast<double>(keys.X[next]) - keys.X[next - 1]), 0.0, 1.0);
+			const DPt3 p = Lerp(ToD(keys.Yp[next - 1]), ToD(keys.Yp[next]), f);
+			const DQuat q = ShortestPathSlerp(f, ToD(keys.Yr[next - 1]), ToD(keys.Yr[next]));
+			err = std::max({ err, Error(out[i].translate, p), Error(out[i].rotate, q) });
+		}
+		Report(quantized ? "NodeTimeline::GetValueAtTime (quantized)" : "NodeTimeline::GetValueAtTime", m, err, "double lerp & shortest path slerp between keys");
+	}
+
+	void BenchQuatsToRotations()
+	{
+		const auto keys = MakeKeys(4099, 100.0f, 4);
+		std::vector<RE::NiMatrix3> out(keys.Yr.size());
+
+		auto reference = [&]() {
+			double err = 0.0;
+			for (size_t i = 0; i < out.size(); i++) {
+				const DQuat q = ToD(keys.Yr[i]);
+				const double tx = q.x * 2.0, ty = q.y * 2.0, tz = q.z * 2.0;
+				const double expected[3][3] = {
+					{ 1.0 - (ty * q.y + tz * q.z), ty * q.x - tz * q.w, tz * q.x + ty * q.w },
+					{ ty * q.x + tz * q.w, 1.0 - (tx * q.x + tz * q.z), tz * q.y - tx * q.w },
+					{ tz * q.x - ty * q.w, tz * q.y + tx * q.w, 1.0 - (tx * q.x + ty * q.y) }
+				};
+				for (size_t r = 0; r < 3; r++) {
+					for (size_t c = 0; c < 3; c++) {
+						err = std::max(err, std::fabs(out[i].entry[r].pt[c] - expected[r][c]));
+					}
+				}
+			}
+			return err;
+		};
+
+		auto m = Measure(out.size(), [&]() {
+			for (size_t i = 0; i < out.size(); i++) {
+				keys.Yr[i].ToRotation(out[i]);
+			}
+			sink = out.back().entry[0].pt[0];
+		});
+		Report("NiQuaternion::ToRotation (stand-in, per element)", m, reference(), "double rotation matrix");
+
+		m = Measure(out.size(), [&]() {
+			MathUtil::QuatsToRotations(keys.Yr, out);
+			sink = out.back().entry[0].pt[0];
+		});
+		Report(MathUtil::BatchRotationMatchesEngine() ? "MathUtil::QuatsToRotations" : "MathUtil::QuatsToRotations (scalar fallback)", m, reference(), "double rotation matrix");
+	}
+
+	//Uses the per-sample operator() for Evaluate, which is what the batched Evaluate implementations replace.
+	template <class Interp>
+	class PerSample : public Interp
+	{
+	public:
+		using Value = std::remove_cvref_t<decltype(std::declval<Interp&>()(0.0f))>;
+
+		virtual void Evaluate(std::span<const float> times, std::span<Value> out) override
+		{
+			MathUtil::InterpolationSystem<Value>::Evaluate(times, out);
+		}
+	};
+
+	template <class Interp, class Y, class D>
+	void BenchInterpolator(const char* name, const std::vector<float>& X, const std::vector<Y>& values, const std::vector<float>& times, const std::vector<D>& ref, const char* reference)
+	{
+		Interp interp;
+		interp.SetData(X, values);
+		std::vector<Y> out(times.size());
+
+		auto m = Measure(times.size(), [&]() {
+			for (size_t i = 0; i < times.size(); i++) {
+				out[i] = interp(times[i]);
+			}
+			sink = out.back().x;
+		});
+		Report((std::string(name) + "::operator()").c_str(), m, MaxError(out, ref), reference);
+
+		m = Measure(times.size(), [&]() {
+			interp.Evaluate(times, out);
+			sink = out.back().x;
+		});
+		Report((std::string(name) + "::Evaluate").c_str(), m, MaxError(out, ref), reference);
+	}
+
+	void BenchInterpolators()
+	{
+		const auto keys = MakeKeys(64, 4.0f, 5);
+		const auto times = MakeTimes(keys.X.front(), keys.X.back(), 2048);
+		const std::vector<double> Xd(keys.X.begin(), keys.X.end());
+
+		auto segmentOf = [&](float t) {
+			return std::clamp(static_cast<size_t>(std::upper_bound(keys.X.begin(), keys.X.end(), t) - keys.X.begin()), static_cast<size_t>(1), keys.X.size() - 1);
+		};
+		auto segmentT = [&](size_t next, float t) {
+			return std::clamp((static_cast<double>(t) - keys.X[next - 1]) / (static_cast<double>(keys.X[next]) - keys.X[next - 1]), 0.0, 1.0);
+		};
+
+		{
+			std::vector<DPt3> ref;
+			for (auto& t : times) {
+				const size_t next = segmentOf(t);
+				ref.push_back(Lerp(ToD(keys.Yp[next - 1]), ToD(keys.Yp[next]), segmentT(next, t)));
+			}
+			BenchInterpolator<MathUtil::Pt3Linear>("MathUtil::Pt3Linear", keys.X, keys.Yp, times, ref, "double lerp");
+		}
+
+		{
+			std::vector<double> Yd[3];
+			for (auto& p : keys.Yp) {
+				Yd[0].push_back(p.x);
+				Yd[1].push_back(p.y);
+				Yd[2].push_back(p.z);
+			}
+			std::vector<DPt3> ref;
+			tk::spline splines[3];
+			for (size_t j = 0; j < 3; j++) {
+				splines[j].set_boundary(tk::spline::first_deriv, 0.0, tk::spline::first_deriv, 0.0);
+				splines[j].set_points(Xd, Yd[j], tk::spline::cspline_hermite);
+			}
+			for (auto& t : times) {
+				ref.push_back({ splines[0](t), splines[1](t), splines[2](t) });
+			}
+			BenchInterpolator<MathUtil::Pt3NaturalCubicSpline>("MathUtil::Pt3NaturalCubicSpline", keys.X, keys.Yp, times, ref, "3 tk::spline hermite fits");
+		}
+
+		{
+			std::vector<DQuat> ref;
+			for (auto& t : times) {
+				const size_t next = segmentOf(t);
+				ref.push_back(Slerp(segmentT(next, t), ToD(keys.Yr[next - 1]), ToD(keys.Yr[next])));
+			}
+			BenchInterpolator<MathUtil::QuatLinear>("MathUtil::QuatLinear", keys.X, keys.Yr, times, ref, "double slerp");
+		}
+
+		{
+			std::vector<DQuat> ref;
+			const size_t n = keys.Yr.size();
+			for (auto& t : times) {
+				const size_t i = segmentOf(t);
+				const DQuat q0 = ToD(keys.Yr[i - 1]);
+				const DQuat q1 = ToD(keys.Yr[i]);
+				const DQuat t0 = Intermediate(ToD(keys.Yr[i - (i > 1 ? 2 : 1)]), q0, q1);
+				const DQuat t1 = Intermediate(q0, q1, ToD(keys.Yr[i + (i + 1 < n ? 1 : 0)]));
+				const double f = segmentT(i, t);
+				ref.push_back(Slerp(2.0 * f * (1.0 - f), Slerp(f, q0, q1), Slerp(f, t0, t1)));
+			}
+			BenchInterpolator<MathUtil::QuatSquadSpline>("MathUtil::QuatSquadSpline", keys.X, keys.Yr, times, ref, "double squad");
+		}
+
+		{
+			std::vector<DQuat> ref;
+			const size_t n = keys.Yr.size();
+			for (auto& t : times) {
+				const size_t i = segmentOf(t);
+				const DQuat r0 = ToD(keys.Yr[i - (i > 1 ? 2 : 1)]);
+				const DQuat r1 = ToD(keys.Yr[i - 1]);
+				const DQuat r2 = ToD(keys.Yr[i]);
+				const DQuat r3 = ToD(keys.Yr[i + (i + 1 < n ? 1 : 0)]);
+				const DPt3 d10 = HermiteDelta(r1, r0), d21 = HermiteDelta(r2, r1), d32 = HermiteDelta(r3, r2);
+				const DPt3 v1{ (d10.x + d21.x) / 2, (d10.y + d21.y) / 2, (d10.z + d21.z) / 2 };
+				const DPt3 v2{ (d21.x + d32.x) / 2, (d21.y + d32.y) / 2, (d21.z + d32.z) / 2 };
+				ref.push_back(QuatHermite(segmentT(i, t), r1, r2, v1, v2));
+			}
+			BenchInterpolator<MathUtil::QuatCatmullRomSpline>("MathUtil::QuatCatmullRomSpline", keys.X, keys.Yr, times, ref, "double dh::quat_hermite");
+		}
+
+		{
+			std::vector<std::pair<double, ysp::quaternion<double>>> combined;
+			for (size_t i = 0; i < keys.X.size(); i++) {
+				const auto& q = keys.Yr[i];
+				combined.emplace_back(keys.X[i], ysp::quaternion<double>(q.w, q.x, q.y, q.z));
+			}
+			ysp::quaternion_spline_curve<double> curve(combined.begin(), combined.end(), true);
+			std::vector<DQuat> ref;
+			for (auto& t : times) {
+				const auto q = curve(t);
+				ref.push_back(Normalize({ q.R_component_1(), q.R_component_2(), q.R_component_3(), q.R_component_4() }));
+			}
+			BenchInterpolator<MathUtil::QuatNaturalCubicSpline>("MathUtil::QuatNaturalCubicSpline", keys.X, keys.Yr, times, ref, "ysp spline in double");
+		}
+	}
+
+	void BenchTkSpline()
+	{
+		//Knots on a known curve, so the reference is the curve itself.
+		auto curve = [](double x) { return std::sin(x * 1.7) * 3.0 + std::cos(x * 0.6); };
+		std::vector<double> X, Y;
+		for (size_t i = 0; i < 64; i++) {
+			X.push_back(static_cast<double>(i) * 0.0625);
+			Y.push_back(curve(X.back()));
+		}
+		const auto times = MakeTimes(0.0f, static_cast<float>(X.back()), 2048);
+		tk::spline s;
+		s.set_points(X, Y);
+		std::vector<double> out(times.size());
+
+		auto m = Measure(times.size(), [&]() {
+			for (size_t i = 0; i < times.size(); i++) {
+				out[i] = s(times[i]);
+			}
+			sink = static_cast<float>(out.back());
+		});
+
+		double err = 0.0;
+		for (size_t i = 0; i < times.size(); i++) {
+			err = std::max(err, std::fabs(out[i] - curve(times[i])));
+		}
+		Report("tk::spline::operator()", m, err, "source curve");
+	}
+
+	void BenchYspSpline()
+	{
+		const auto keys = MakeKeys(64, 4.0f, 6);
+		const auto times = MakeTimes(keys.X.front(), keys.X.back(), 2048);
+		std::vector<std::pair<float, ysp::quaternion<float>>> combined;
+		std::vector<std::pair<double, ysp::quaternion<double>>> combinedD;
+		for (size_t i = 0; i < keys.X.size(); i++) {
+			const auto& q = keys.Yr[i];
+			combined.emplace_back(keys.X[i], ysp::quaternion<float>(q.w, q.x, q.y, q.z));
+			combinedD.emplace_back(keys.X[i], ysp::quaternion<double>(q.w, q.x, q.y, q.z));
+		}
+		ysp::quaternion_spline_curve<float> curve(combined.begin(), combined.end(), true);
+		ysp::quaternion_spline_curve<double> curveD(combinedD.begin(), combinedD.end(), true);
+		std::vector<RE::NiQuaternion> out(times.size());
+
+		auto m = Measure(times.size(), [&]() {
+			for (size_t i = 0; i < times.size(); i++) {
+				const auto q = curve(times[i]);
+				out[i] = { q.R_component_1(), q.R_component_2(), q.R_component_3(), q.R_component_4() };
+			}
+			sink = out.back().w;
+		});
+
+		std::vector<DQuat> ref;
+		for (auto& t : times) {
+			const auto q = curveD(t);
+			ref.push_back({ q.R_component_1(), q.R_component_2(), q.R_component_3(), q.R_component_4() });
+		}
+		Report("ysp::quaternion_spline_curve::operator()", m, MaxError(out, ref), "ysp spline in double");
+
+		m = Measure(1, [&]() {
+			ysp::quaternion_spline_curve<float> fit(combined.begin(), combined.end(), true);
+			sink = fit(1.0f).R_component_1();
+		});
+		std::printf("%-54s %10.2f %10.3f %12s  %s\n", "ysp::quaternion_spline_curve fit (64 keys, per fit)", m.nsPerSample, m.allocsPerSample, "-", "-");
+	}
+
+	void BenchQuatHermite()
+	{
+		const auto keys = MakeKeys(65, 4.0f, 7);
+		const auto times = MakeTimes(0.0f, 1.0f, 32);
+		const size_t segments = keys.Yr.size() - 1;
+
+		struct Segment
+		{
+			dh::quat q1, q2;
+			dh::vec3 v1, v2;
+		};
+		std::vector<Segment> segs;
+		auto toDh = [](const RE::NiQuaternion& q) { return dh::quat(q.w, q.x, q.y, q.z); };
+		for (size_t i = 1; i <= segments; i++) {
+			Segment s{ toDh(keys.Yr[i - 1]), toDh(keys.Yr[i]), {}, {} };
+			dh::quat_catmull_rom_velocity(s.v1, s.v2, toDh(keys.Yr[i - (i > 1 ? 2 : 1)]), s.q1, s.q2, toDh(keys.Yr[i + (i < segments ? 1 : 0)]));
+			segs.push_back(s);
+		}
+		std::vector<RE::NiQuaternion> out(segments * times.size());
+
+		auto m = Measure(out.size(), [&]() {
+			size_t k = 0;
+			for (auto& s : segs) {
+				for (auto& t : times) {
+					dh::quat_hermite(reinterpret_cast<dh::quat&>(out[k++]), t, s.q1, s.q2, s.v1, s.v2);
+				}
+			}
+			sink = out.back().w;
+		});
+
+		std::vector<DQuat> ref;
+		for (auto& s : segs) {
+			for (auto& t : times) {
+				ref.push_back(QuatHermite(t, { s.q1.w, s.q1.x, s.q1.y, s.q1.z }, { s.q2.w, s.q2.x, s.q2.y, s.q2.z }, { s.v1.x, s.v1.y, s.v1.z }, { s.v2.x, s.v2.y, s.v2.z }));
+			}
+		}
+		Report("dh::quat_hermite", m, MaxError(out, ref), "double hermite with the same velocities");
+	}
+
+	void BenchEasing()
+	{
+		using F = double (*)(double);
+		const F functions[] = {
+			Easing::easeNone, Easing::easeInSine, Easing::easeOutSine, Easing::easeInOutSine,
+			Easing::easeInQuad, Easing::easeOutQuad, Easing::easeInOutQuad,
+			Easing::easeInCubic, Easing::easeOutCubic, Easing::easeInOutCubic,
+			Easing::easeInQuart, Easing::easeOutQuart, Easing::easeInOutQuart,
+			Easing::easeInQuint, Easing::easeOutQuint, Easing::easeInOutQuint,
+			Easing::easeInExpo, Easing::easeOutExpo, Easing::easeInOutExpo,
+			Easing::easeInCirc, Easing::easeOutCirc, Easing::easeInOutCirc,
+			Easing::easeInBack, Easing::easeOutBack, Easing::easeInOutBack,
+			Easing::easeInElastic, Easing::easeOutElastic, Easing::easeInOutElastic,
+			Easing::easeInBounce, Easing::easeOutBounce, Easing::easeInOutBounce
+		};
+		constexpr size_t count = sizeof(functions) / sizeof(F);
+		const auto times = MakeTimes(0.0f, 1.0f, 256);
+		std::vector<double> out(count * times.size());
+
+		auto m = Measure(out.size(), [&]() {
+			size_t k = 0;
+			for (size_t f = 0; f < count; f++) {
+				for (auto& t : times) {
+					out[k++] = Easing::Ease(t, static_cast<Easing::Function>(f));
+				}
+			}
+			sink = static_cast<float>(out.back());
+		});
+
+		double err = 0.0;
+		size_t k = 0;
+		for (size_t f = 0; f < count; f++) {
+			for (auto& t : times) {
+				err = std::max(err, std::fabs(out[k++] - functions[f](t)));
+			}
+		}
+		Report("Easing::Ease (all functions)", m, err, "direct ease function calls");
+	}
+
+	BodyAnimation::FrameBasedNodeAnimation MakeFrameBasedAnimation()
+	{
+		BodyAnimation::FrameBasedNodeAnimation result;
+		result.duration = 120;
+		result.timelines.resize(80);
+		for (size_t i = 0; i < result.timelines.size(); i++) {
+			auto& tl = result.timelines[i];
+			//A mix of looping, non-looping, 2 key, constant & empty tracks.
+			const size_t keyCount = i % 10 == 9 ? 0 : i % 10 == 8 ? 1 : i % 10 == 7 ? 2 : 5 + (i % 7) * 2;
+			if (keyCount == 0)
+				continue;
+
+			const auto keys = MakeKeys(std::max(keyCount, static_cast<size_t>(2)), 1.0f, static_cast<uint32_t>(100 + i));
+			const bool looping = i % 2 == 0;
+			const size_t lastFrame = looping ? result.duration - 1 : result.duration - 1 - (i % 5) * 4;
+			for (size_t k = 0; k < keyCount; k++) {
+				const size_t frame = keyCount > 1 ? (k * lastFrame) / (keyCount - 1) : 0;
+				tl.keys[frame].value = NodeTransform{ keys.Yr[k], keys.Yp[k] };
+			}
+			if (looping && keyCount > 2)
+				tl.keys[lastFrame] = tl.keys[0];
+		}
+		return result;
+	}
+
+	template <class Rot, class Pos>
+	void BenchToRuntimeSampled(const char* name)
+	{
+		auto anim = MakeFrameBasedAnimation();
+		auto rotCreator = []() { return std::make_unique<Rot>(); };
+		auto posCreator = []() { return std::make_unique<Pos>(); };
+		auto refRotCreator = []() { return std::make_unique<PerSample<Rot>>(); };
+		auto refPosCreator = []() { return std::make_unique<PerSample<Pos>>(); };
+
+		auto result = anim.ToRuntimeSampled(rotCreator, posCreator);
+		size_t samples = 0;
+		for (auto& tl : result->timelines) {
+			samples += tl.keys.size();
+		}
+
+		auto m = Measure(samples, [&]() {
+			auto r = anim.ToRuntimeSampled(rotCreator, posCreator);
+			sink = static_cast<float>(r->timelines.size());
+		});
+
+		auto ref = anim.ToRuntimeSampled(refRotCreator, refPosCreator);
+		double err = 0.0;
+		for (size_t i = 0; i < result->timelines.size(); i++) {
+			auto& a = result->timelines[i].keys;
+			auto& b = ref->timelines[i].keys;
+			if (a.size() != b.size()) {
+				err = INFINITY;
+				continue;
+			}
+			for (auto ia = a.begin(), ib = b.begin(); ia != a.end(); ++ia, ++ib) {
+				err = std::max({ err, static_cast<double>(std::fabs(ia->first - ib->first)), Error(ia->second.value, ib->second.value) });
+			}
+		}
+		Report((std::string("FrameBasedNodeAnimation::ToRuntimeSampled ") + name).c_str(), m, err, "per-sample operator() resampling");
+	}
+
+	//The event bus before typed channels, kept as the reference for the dispatch benchmarks.
+	class LegacyEvents
+	{
+	public:
+		typedef Data::Events::event_type event_type;
+		typedef std::any EventData;
+		typedef std::function<void(event_type, EventData&)> EventFunctor;
+		typedef std::list<EventFunctor>::iterator EventRegistration;
+
+		static EventRegistration Subscribe(event_type evnt, EventFunctor receiver)
+		{
+			std::unique_lock l{ lock };
+			registrations[evnt].push_back(receiver);
+			return --registrations[evnt].end();
+		}
+
+		static void Unsubscribe(event_type evnt, EventRegistration reg)
+		{
+			std::unique_lock l{ lock };
+			if (registrations.contains(evnt)) {
+				for (auto iter = registrations[evnt].begin(); iter != registrations[evnt].end();) {
+					if (std::addressof(*iter) == std::addressof(*reg)) {
+						iter = registrations[evnt].erase(iter);
+						break;
+					} else {
+						iter++;
+					}
+				}
+			}
+		}
+
+		static void SendMutable(event_type evnt, EventData& data)
+		{
+			std::unique_lock l{ lock };
+			if (registrations.contains(evnt)) {
+				for (auto& f : registrations[evnt]) {
+					f(evnt, data);
+				}
+			}
+		}
+
+		static void Send(event_type evnt, const EventData& data = false)
+		{
+			EventData e = data;
+			SendMutable(evnt, e);
+		}
+
+	private:
+		inline static std::unordered_map<event_type, std::list<EventFunctor>> registrations;
+		inline static safe_mutex lock;
+	};
+
+	enum class Bus
+	{
+		Legacy,
+		Typed,
+		Erased,
+		Deferred
+	};
+
+	uint64_t PayloadValue(uint64_t p) { return p; }
+	uint64_t PayloadValue(const Data::Events::SceneData& p) { return p.id + p.actors.size(); }
+
+	//Sends events with the given payload to subscriberCount subscribers, which sum up what they receive.
+	template <Data::Events::event_type E>
+	void BenchEventDispatch(Bus bus, size_t subscriberCount, const Data::Events::Payload<E>& payload, const char* name, const char* reference)
+	{
+		using Events = Data::Events;
+		using P = Events::Payload<E>;
+		constexpr size_t batchSize = 64;
+		uint64_t received = 0;
+
+		std::vector<LegacyEvents::EventRegistration> legacyRegs;
+		std::vector<Events::EventRegistration> regs;
+		for (size_t i = 0; i < subscriberCount; i++) {
+			switch (bus) {
+			case Bus::Legacy:
+				legacyRegs.push_back(LegacyEvents::Subscribe(E, [&received](LegacyEvents::event_type, LegacyEvents::EventData& data) {
+					received += PayloadValue(std::any_cast<P&>(data));
+				}));
+				break;
+			case Bus::Erased:
+				regs.push_back(Events::Subscribe(E, [&received](Events::event_type, Events::EventData& data) {
+					received += PayloadValue(std::any_cast<P&>(data));
+				}));
+				break;
+			default:
+				regs.push_back(Events::Subscribe<E>([&received](Events::event_type, const P& data) {
+					received += PayloadValue(data);
+				}));
+				break;
+			}
+		}
+
+		auto sendBatch = [&]() {
+			for (size_t i = 0; i < batchSize; i++) {
+				switch (bus) {
+				case Bus::Legacy:
+					LegacyEvents::Send(E, payload);
+					break;
+				case Bus::Deferred:
+					Events::Post<E>(payload);
+					break;
+				default:
+					Events::Send<E>(payload);
+					break;
+				}
+			}
+			if (bus == Bus::Deferred)
+				Events::DispatchDeferred();
+		};
+
+		auto m = Measure(batchSize, [&]() {
+			sendBatch();
+			sink = static_cast<float>(received);
+		});
+
+		received = 0;
+		sendBatch();
+		const double expected = static_cast<double>(PayloadValue(payload) * subscriberCount * batchSize);
+		const double err = std::fabs(static_cast<double>(received) - expected);
+
+		for (auto& r : legacyRegs) {
+			LegacyEvents::Unsubscribe(E, r);
+		}
+		for (auto& r : regs) {
+			Events::Unsubscribe(r);
+		}
+		Events::DispatchDeferred();
+
+		char label[128];
+		std::snprintf(label, sizeof(label), "%s (%zu subscribers)", name, subscriberCount);
+		Report(label, m, err, reference);
+	}
+
+	void BenchEvents()
+	{
+		using Events = Data::Events;
+		const uint64_t id = 7;
+		Events::SceneData scene{ 7, { nullptr, nullptr } };
+
+		for (size_t count : { 1, 4, 16 }) {
+			BenchEventDispatch<Events::SCENE_START>(Bus::Legacy, count, id, "LegacyEvents::Send uint64_t", "");
+			BenchEventDispatch<Events::SCENE_START>(Bus::Typed, count, id, "Events::Send<E> uint64_t", "LegacyEvents::Send");
+			BenchEventDispatch<Events::SCENE_START>(Bus::Erased, count, id, "Events::Send<E> uint64_t, EventData receivers", "LegacyEvents::Send");
+			BenchEventDispatch<Events::SCENE_START>(Bus::Deferred, count, id, "Events::Post<E> + DispatchDeferred uint64_t", "LegacyEvents::Send");
+		}
+
+		for (size_t count : { 1, 4 }) {
+			BenchEventDispatch<Events::SCENE_END>(Bus::Legacy, count, scene, "LegacyEvents::Send SceneData", "");
+			BenchEventDispatch<Events::SCENE_END>(Bus::Typed, count, scene, "Events::Send<E> SceneData", "LegacyEvents::Send");
+			BenchEventDispatch<Events::SCENE_END>(Bus::Erased, count, scene, "Events::Send<E> SceneData, EventData receivers", "LegacyEvents::Send");
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1) {
+		minDuration = std::chrono::milliseconds(std::max(1, std::atoi(argv[1])));
+	}
+
+	std::printf("%-54s %10s %10s %12s  %s\n", "kernel", "ns/sample", "allocs/smp", "max error", "reference");
+	BenchNodeTransformLerp();
+	BenchNodeTimeline(false);
+	BenchNodeTimeline(true);
+	BenchQuatsToRotations();
+	BenchInterpolators();
+	BenchTkSpline();
+	BenchYspSpline();
+	BenchQuatHermite();
+	BenchEasing();
+	BenchToRuntimeSampled<MathUtil::QuatLinear, MathUtil::Pt3Linear>("(linear)");
+	BenchToRuntimeSampled<MathUtil::QuatSquadSpline, MathUtil::Pt3NaturalCubicSpline>("(squad)");
+	BenchToRuntimeSampled<MathUtil::QuatCatmullRomSpline, MathUtil::Pt3NaturalCubicSpline>("(catmull-rom)");
+	BenchToRuntimeSampled<MathUtil::QuatNaturalCubicSpline, MathUtil::Pt3NaturalCubicSpline>("(natural cubic)");
+	BenchEvents();
+	return 0;
+}
@@ -42,6 +42,8 @@ namespace BodyAnimation
 		struct PersistentState
 		{
 			std::unordered_map<RE::IAnimationGraphManagerHolder*, NodeAnimationGraph> graphs;
+			//Animations restored from a save, waiting for OnLoad to restart them. Not serialized.
+			std::vector<GraphStateInfo> loadedInfos;
 
 			template <class Archive>
 			void save(Archive& ar, const uint32_t) const
@@ -59,20 +61,7 @@ namespace BodyAnimation
 			template <class Archive>
 			void load(Archive& ar, const uint32_t)
 			{
-				std::vector<GraphStateInfo> infos;
-				ar(infos);
-				for (const auto& i : infos) {
-					auto ref = i.ref.get();
-					if (ref == nullptr)
-						continue;
-
-					if (auto animData = LoadAnimation(ref.get(), i.animInfo.filePath, i.animInfo.id); animData != nullptr) {
-						StartAnimation(ref.get(), std::move(animData), 0.0f, i.animInfo.filePath, i.animInfo.id);
-						if (auto g = GetGraph(ref.get()); g != nullptr) {
-							g->generator.localTime = i.animTime;
-						}
-					}
-				}
+				ar(loadedInfos);
 			}
 		};
 
@@ -103,6 +92,7 @@ namespace BodyAnimation
 			if (!file.GetAnimation(id, info->nodeList, animData))
 				return nullptr;
 
+			animData->Compress();
 			return animData;
 		}
 
@@ -122,7 +112,7 @@ namespace BodyAnimation
 			}
 		}
 
-		static bool LoadAndPlayAnimation(RE::TESObjectREFR* ref, const std::string& filePath, float transitionDur = 1.3f, const std::string& animName = "default")
+		static bool LoadAndPlayAnimation(RE::TESObjectREFR* ref, const std::string& filePath, float transitionDur = 1.3f, const std::string& animName = "default", float startTime = 0.0f)
 		{
 			if (!ref)
 				return false;
@@ -136,23 +126,27 @@ namespace BodyAnimation
 			std::unique_lock l{ loadingAnimsLock };
 			loadingAnims[hndl] = { filePath, animName };
 
-			std::thread([filePath = filePath, animName = animName, info = info, hndl = hndl, transitionDur = transitionDur]() {
-				auto animData = LoadAnimation(info, filePath, animName);
-				auto ref = hndl.get();
-
-				std::unique_lock l{ loadingAnimsLock };
-				if (auto iter = loadingAnims.find(hndl); iter != loadingAnims.end() && iter->second.filePath == filePath && iter->second.id == animName) {
-					if (animData != nullptr && ref != nullptr) {
-						StartAnimation(ref.get(), std::move(animData), transitionDur, filePath, animName);
-					}
-					loadingAnims.erase(hndl);
-				}
-
+			std::thread([filePath = filePath, animName = animName, info = info, hndl = hndl, transitionDur = transitionDur, startTime = startTime]() {
+				OnAnimationLoaded(hndl, filePath, animName, LoadAnimation(info, filePath, animName), transitionDur, startTime);
 			}).detach();
 
 			return true;
 		}
 
+		//Starts an animation that finished loading in the background, unless the ref's load was cancelled or replaced in the meantime.
+		static void OnAnimationLoaded(const SerializableRefHandle& hndl, const std::string& filePath, const std::string& animName, std::unique_ptr<NodeAnimation> animData, float transitionDur, float startTime)
+		{
+			auto ref = hndl.get();
+
+			std::unique_lock l{ loadingAnimsLock };
+			if (auto iter = loadingAnims.find(hndl); iter != loadingAnims.end() && iter->second.filePath == filePath && iter->second.id == animName) {
+				if (animData != nullptr && ref != nullptr && StartAnimation(ref.get(), std::move(animData), transitionDur, filePath, animName) && startTime > 0.0f) {
+					VisitGraph(ref.get(), [startTime](NodeAnimationGraph* g) { g->generator.localTime = startTime; }, false);
+				}
+				loadingAnims.erase(hndl);
+			}
+		}
+
 		static bool StartAnimation(RE::TESObjectREFR* ref, std::unique_ptr<NodeAnimation> anim, float transitionDur = 1.3f, const std::string_view& filePath = "", const std::string_view& id = "")
 		{
 			if (!ref || !anim)
@@ -210,6 +204,27 @@ namespace BodyAnimation
 			return false;
 		}
 
+		//Visits the existing graphs of all refs at once, holding each graph's update lock for the duration of visitFunc.
+		//Refs without a graph are passed as nullptr.
+		static void VisitGraphs(const std::vector<RE::TESObjectREFR*>& refs, std::function<void(const std::vector<NodeAnimationGraph*>&)> visitFunc) {
+			std::shared_lock ls{ stateLock };
+			std::vector<NodeAnimationGraph*> graphs;
+			std::vector<std::unique_lock<std::mutex>> locks;
+			graphs.reserve(refs.size());
+			locks.reserve(refs.size());
+
+			for (auto& r : refs) {
+				auto g = r != nullptr ? GetGraph(r) : nullptr;
+				if (g != nullptr && std::find(graphs.begin(), graphs.end(), g) == graphs.end()) {
+					locks.emplace_back(g->updateLock);
+				}
+				graphs.push_back(g);
+			}
+
+			if (visitFunc != nullptr)
+				visitFunc(graphs);
+		}
+
 		static bool DeleteGraph(RE::TESObjectREFR* ref) {
 			if (!ref)
 				return false;
@@ -268,6 +283,7 @@ namespace BodyAnimation
 
 		static void HookedSet3D(RE::TESObjectREFR* a_ref, RE::NiAVObject* a_object, bool a_queue) {
 			OriginalSet3d(a_ref, a_object, a_queue);
+			GameUtil::OnRef3DSet(a_ref, a_object);
 			std::shared_lock l1{ stateLock };
 			std::shared_lock l2{ regsFor3dLock };
 
@@ -283,6 +299,65 @@ namespace BodyAnimation
 			}
 		}
 
+		//Restarts the animations that were playing when the game was saved once the loaded state has been swapped in.
+		//Refs that saved the same file and id with the same skeleton share one load, and each unique animation is loaded
+		//in parallel in the background. Every ref gets its own copy and resumes from its saved time.
+		static void OnLoad() {
+			std::vector<GraphStateInfo> infos;
+			{
+				std::unique_lock l{ stateLock };
+				infos = std::move(state->loadedInfos);
+				state->loadedInfos.clear();
+			}
+
+			struct LoadGroup
+			{
+				std::shared_ptr<const Data::GraphInfo> info;
+				AnimationInfo animInfo;
+				std::vector<std::pair<SerializableRefHandle, float>> targets;
+			};
+
+			std::vector<LoadGroup> groups;
+			std::map<std::tuple<const Data::GraphInfo*, std::string, std::string>, size_t> groupIndex;
+			{
+				std::unique_lock l{ loadingAnimsLock };
+				for (const auto& i : infos) {
+					auto ref = i.ref.get();
+					if (ref == nullptr)
+						continue;
+
+					auto info = GetGraphInfo(ref.get());
+					if (!info)
+						continue;
+
+					auto [iter, inserted] = groupIndex.try_emplace({ info.get(), Utility::StringToLower(i.animInfo.filePath), i.animInfo.id }, groups.size());
+					if (inserted) {
+						groups.push_back({ info, i.animInfo });
+					}
+					auto& g = groups[iter->second];
+					g.targets.emplace_back(i.ref, i.animTime);
+					//Registered with the group's spelling of the path, which OnAnimationLoaded compares against.
+					loadingAnims[i.ref] = g.animInfo;
+				}
+			}
+
+			if (groups.empty())
+				return;
+
+			std::thread([groups = std::move(groups)]() mutable {
+				concurrency::parallel_for_each(groups.begin(), groups.end(), [](LoadGroup& g) {
+					auto animData = LoadAnimation(g.info, g.animInfo.filePath, g.animInfo.id);
+					for (size_t i = 0; i < g.targets.size(); i++) {
+						std::unique_ptr<NodeAnimation> inst = nullptr;
+						if (animData != nullptr) {
+							inst = (i + 1 < g.targets.size()) ? std::make_unique<NodeAnimation>(*animData) : std::move(animData);
+						}
+						OnAnimationLoaded(g.targets[i].first, g.animInfo.filePath, g.animInfo.id, std::move(inst), 0.0f, g.targets[i].second);
+					}
+				});
+			}).detach();
+		}
+
 		static void Reset() {
 			std::scoped_lock l{ loadingAnimsLock, stateLock, regsFor3dLock };
 			state->graphs.clear();
@@ -306,6 +381,7 @@ namespace BodyAnimation
 
 			if (Set3dDetour.Create(reinterpret_cast<LPVOID>(hookLoc2.address()), &HookedSet3D)) {
 				OriginalSet3d = reinterpret_cast<uintptr_t>(Set3dDetour.GetTrampoline());
+				GameUtil::EnableLoadedCellTracking();
 			} else {
 				logger::warn("Failed to create TESObjectREFR::Set3D hook!");
 			}
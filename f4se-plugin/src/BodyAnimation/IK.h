@@ -726,6 +726,17 @@ namespace BodyAnimation
 			return result;
 		}
 
+		//Gets the refs that enabled chains have their targets parented to.
+		std::vector<SerializableRefHandle> GetTargetParentRefs() {
+			std::vector<SerializableRefHandle> result;
+			for (auto& h : holders) {
+				if (h->holderEnabled && h->targetRef) {
+					result.push_back(h->targetRef);
+				}
+			}
+			return result;
+		}
+
 		void ResetChainTarget(const std::string& id) {
 			for (auto& h : holders) {
 				if (h->holderId == id) {
@@ -482,18 +482,92 @@ namespace BodyAnimation
 			return result;
 		}
 
-		void SetAnimation(const std::string& name, const std::vector<std::string>& graphNodeList, const NodeAnimation* anim)
+		void SetAnimation(const std::string& name, const std::vector<std::string>& graphNodeList, const NodeAnimation* anim, const std::optional<KeyReduction>& reduction = std::nullopt)
 		{
 			auto& data = animations.value[name];
 			data.timelines.clear();
 			data.duration = anim->duration;
-			for (size_t i = 0; i < anim->timelines.size() && i < graphNodeList.size(); i++) {
+			size_t count = std::min(anim->timelines.size(), graphNodeList.size());
+			auto targets = GetTimelineTargets(data, graphNodeList, count);
+
+			concurrency::parallel_for(static_cast<size_t>(0), count, [&](size_t i) {
 				auto& runtimeTL = anim->timelines[i];
-				auto& targetTL = data.timelines[graphNodeList[i]];
+				if (targets[i] == nullptr)
+					return;
+
+				auto& targetTL = *targets[i];
+				if (!reduction.has_value()) {
+					for (auto& k : runtimeTL.keys) {
+						targetTL.emplace_back(k.first, k.second.value.translate, k.second.value.rotate);
+					}
+					return;
+				}
+
+				std::vector<float> times;
+				std::vector<NodeTransform> values;
+				times.reserve(runtimeTL.keys.size());
+				values.reserve(runtimeTL.keys.size());
 				for (auto& k : runtimeTL.keys) {
-					targetTL.emplace_back(k.first, k.second.value.translate, k.second.value.rotate);
+					times.push_back(k.first);
+					values.push_back(k.second.value);
 				}
+
+				std::vector<size_t> keep;
+				KeyReduction::Reduce(times.data(), values.data(), 1, times.size(), reduction->GetTolerance(graphNodeList[i]), keep);
+				targetTL.reserve(keep.size());
+				for (auto& k : keep) {
+					targetTL.emplace_back(times[k], values[k].translate, values[k].rotate);
+				}
+			});
+		}
+
+		//Creates a timeline for each of the first 'count' nodes, so they can then be filled in parallel.
+		//If a node name is listed more than once, only its first index gets a target.
+		static std::vector<AnimationData::AnimationTimeline*> GetTimelineTargets(AnimationData& data, const std::vector<std::string>& graphNodeList, size_t count) {
+			std::vector<AnimationData::AnimationTimeline*> result(count, nullptr);
+			for (size_t i = 0; i < count; i++) {
+				auto [iter, inserted] = data.timelines.try_emplace(graphNodeList[i]);
+				if (inserted)
+					result[i] = &iter->second;
 			}
+			return result;
+		}
+
+		//Sets an animation from flat, frame-major samples (times.size() rows of sampleStride transforms each).
+		//Nodes with nodeHasSamples[i] == 0 are written as empty timelines.
+		void SetAnimationFromSamples(const std::string& name, const std::vector<std::string>& graphNodeList, float duration, size_t timelineCount,
+			const std::vector<float>& times, size_t frameCount, const std::vector<NodeTransform>& samples, const std::vector<uint8_t>& nodeHasSamples, size_t sampleStride,
+			const std::optional<KeyReduction>& reduction = std::nullopt)
+		{
+			frameCount = std::min(frameCount, times.size());
+			auto& data = animations.value[name];
+			data.timelines.clear();
+			data.duration = duration;
+			size_t count = std::min(timelineCount, graphNodeList.size());
+			auto targets = GetTimelineTargets(data, graphNodeList, count);
+
+			concurrency::parallel_for(static_cast<size_t>(0), count, [&](size_t i) {
+				if (targets[i] == nullptr || i >= nodeHasSamples.size() || !nodeHasSamples[i])
+					return;
+
+				auto& targetTL = *targets[i];
+
+				std::vector<size_t> keep;
+				if (reduction.has_value()) {
+					KeyReduction::Reduce(times.data(), samples.data() + i, sampleStride, frameCount, reduction->GetTolerance(graphNodeList[i]), keep);
+				} else {
+					keep.resize(frameCount);
+					for (size_t f = 0; f < keep.size(); f++) {
+						keep[f] = f;
+					}
+				}
+
+				targetTL.reserve(keep.size());
+				for (auto& f : keep) {
+					const auto& t = samples[f * sampleStride + i];
+					targetTL.emplace_back(times[f], t.translate, t.rotate);
+				}
+			});
 		}
 
 		void SetAnimationFromPose(const std::string& name, float duration, const std::vector<std::string>& graphNodeList, const std::vector<NodeTransform>& pose)
@@ -11,6 +11,25 @@ namespace BodyAnimation
 		float localTime = 0.0f;
 		std::vector<NodeTransform> output;
 		std::unique_ptr<NodeAnimation> animData = nullptr;
+		//Changes every time animData is replaced, so holders can tell animations apart even if one reuses another's address.
+		uint64_t animationId = 0;
+		inline static std::atomic<uint64_t> nextAnimationId = 0;
+
+		//Called from Update, under the graph's update lock, whenever localTime wraps back to the start.
+		//Kept when the animation is replaced, so whoever set it keeps hearing about loops until they clear it.
+		std::function<void()> loopListener = nullptr;
+
+		//A constant track's transform, already in the form written to the node.
+		struct ConstantTrack
+		{
+			uint32_t index;
+			RE::NiMatrix3 rotate;
+			RE::NiPoint3 translate;
+		};
+
+		//Only animated tracks are sampled each update. Constant tracks are written to output once, and empty tracks are left as identity.
+		std::vector<uint32_t> animatedTracks;
+		std::vector<ConstantTrack> constantTracks;
 
 		bool HasAnimation() const {
 			return animData != nullptr;
@@ -18,6 +37,7 @@ namespace BodyAnimation
 
 		void SetAnimation(std::unique_ptr<NodeAnimation> anim) {
 			animData = std::move(anim);
+			animationId = ++nextAnimationId;
 			output.clear();
 			if (animData != nullptr) {
 				output.resize(animData->timelines.size());
@@ -25,17 +45,52 @@ namespace BodyAnimation
 					t.Init();
 				}
 			}
+			ClassifyTracks();
+		}
+
+		//Must be called whenever animData's timelines are modified in-place.
+		void ClassifyTracks() {
+			animatedTracks.clear();
+			constantTracks.clear();
+			if (animData == nullptr)
+				return;
+
+			for (size_t i = 0; i < animData->timelines.size(); i++) {
+				auto& tl = animData->timelines[i];
+				switch (tl.GetTrackType()) {
+				case NodeTimeline::kEmpty:
+					output[i].MakeIdentity();
+					break;
+				case NodeTimeline::kConstant:
+					output[i] = tl.keys.begin()->second.value;
+					if (!output[i].IsIdentity()) {
+						auto& c = constantTracks.emplace_back();
+						c.index = static_cast<uint32_t>(i);
+						output[i].rotate.ToRotation(c.rotate);
+						c.translate = output[i].translate;
+					}
+					break;
+				default:
+					animatedTracks.push_back(static_cast<uint32_t>(i));
+					break;
+				}
+			}
 		}
 
 		void Update(float deltaTime) {
 			if (!paused) {
 				localTime += deltaTime;
-				while (localTime >= animData->duration) {
-					localTime -= animData->duration;
+				if (localTime >= animData->duration) {
+					while (localTime >= animData->duration) {
+						localTime -= animData->duration;
+					}
+
+					if (loopListener != nullptr)
+						loopListener();
 				}
 			}
 
-			for (size_t i = 0; i < animData->timelines.size(); i++) {
+			for (const auto& i : animatedTracks) {
 				animData->timelines[i].GetValueAtTime(localTime, output[i]);
 			}
 		}
@@ -80,7 +135,7 @@ namespace BodyAnimation
 		{
 			std::thread([data = std::move(animData), filePath = filePath, nodeMap = nodeMap]() {
 				NANIM file;
-				file.SetAnimation("default", nodeMap, data.get());
+				file.SetAnimation("default", nodeMap, data.get(), KeyReduction::FromSettings());
 				file.SaveToFile(filePath);
 			}).detach();
 			animData = nullptr;
@@ -109,22 +164,46 @@ namespace BodyAnimation
 
 		struct BAKE_DATA
 		{
-			std::unique_ptr<NodeAnimation> animData;
+			float duration = 0.0f;
+			size_t timelineCount = 0;
 			size_t updateCount;
+			size_t frame = 0;
+			//Number of rows of samples which have actually been sampled, only these are written out.
+			size_t sampledFrames = 0;
 			float curTime = 0.0f;
 			float sampleRate = 0.1f;
+			std::vector<float> times;
+			std::vector<uint8_t> nodeHasSamples;
+			//Frame-major, updateCount transforms per frame. Preallocated by SetupBake.
+			std::vector<NodeTransform> samples;
+
+			void GenerateTimes() {
+				times.clear();
+				float t = 0.0f;
+				times.push_back(t);
+				while (true) {
+					auto next = t + sampleRate;
+					if (next < duration) {
+						t = next;
+					} else if (std::fabs(t - duration) < 0.001f) {
+						break;
+					} else {
+						t = duration;
+					}
+					times.push_back(t);
+				}
+			}
 
 			bool StepForward() {
-				auto next = curTime + sampleRate;
-				if (next < animData->duration) {
-					curTime = next;
-					return true;
-				} else if (std::fabs(curTime - animData->duration) < 0.001f) {
-					return false;
-				} else {
-					curTime = animData->duration;
+				if (frame + 1 < times.size()) {
+					curTime = times[++frame];
 					return true;
 				}
+				return false;
+			}
+
+			void WriteTo(NANIM& container, const std::string& name, const std::vector<std::string>& nodeMap, const std::optional<KeyReduction>& reduction = std::nullopt) const {
+				container.SetAnimationFromSamples(name, nodeMap, duration, timelineCount, times, sampledFrames, samples, nodeHasSamples, updateCount, reduction);
 			}
 		};
 
@@ -171,6 +250,9 @@ namespace BodyAnimation
 		InterpType posInterpType = kNaturalCubic;
 		InterpType rotInterpType = kSquad;
 
+		//The generator's animationId as of the last full sampled push, which single timelines can be resampled into.
+		std::optional<uint64_t> sampledAnimId;
+
 		NodeAnimationCreator(NodeAnimationGenerator* gen, std::vector<RE::NiPointer<RE::NiAVObject>>* nodes, std::vector<std::string>* nMap, IKManager* ikMan)
 		{
 			nodeList = nodes;
@@ -185,11 +267,16 @@ namespace BodyAnimation
 		BAKE_DATA SetupBake() {
 			PushDataToGenerator(true);
 			BAKE_DATA result;
-			result.animData = std::make_unique<NodeAnimation>();
-			result.animData->duration = animData->GetRuntimeDuration() - animData->sampleRate;
-			result.animData->timelines.resize(animData->timelines.size());
+			result.duration = animData->GetRuntimeDuration() - animData->sampleRate;
+			result.timelineCount = animData->timelines.size();
 			result.updateCount = animData->timelines.size() < nodeList->size() ? animData->timelines.size() : nodeList->size();
 			result.sampleRate = animData->sampleRate;
+			result.GenerateTimes();
+			result.nodeHasSamples.resize(result.updateCount);
+			for (size_t i = 0; i < result.updateCount; i++) {
+				result.nodeHasSamples[i] = nodeList->at(i) != nullptr;
+			}
+			result.samples.resize(result.times.size() * result.updateCount);
 			return result;
 		}
 
@@ -208,10 +295,12 @@ namespace BodyAnimation
 		}
 
 		void SampleAtTime(BAKE_DATA& data) {
+			NodeTransform* row = data.samples.data() + (data.frame * data.updateCount);
 			for (size_t i = 0; i < data.updateCount; i++) {
-				if (nodeList->at(i) != nullptr)
-					data.animData->timelines[i].keys[data.curTime].value = nodeList->at(i)->local;
+				if (data.nodeHasSamples[i] && nodeList->at(i) != nullptr)
+					row[i] = nodeList->at(i)->local;
 			}
+			data.sampledFrames = std::max(data.sampledFrames, data.frame + 1);
 		}
 
 		void BakeToNANIM(const std::string& name, NANIM& container) {
@@ -223,7 +312,7 @@ namespace BodyAnimation
 				SampleAtTime(data);
 			} while (data.StepForward());
 			
-			container.SetAnimation(name, *nodeMap, data.animData.get());
+			data.WriteTo(container, name, *nodeMap, KeyReduction::FromSettings());
 		}
 
 		void SaveToNANIM(const std::string& name, NANIM& container) {
@@ -308,39 +397,69 @@ namespace BodyAnimation
 					selectiveNodeIndex.value() < generator->animData->timelines.size())
 				{
 					animData->UpdateRuntimeSelective(*selectiveNodeIndex, generator->animData->timelines[*selectiveNodeIndex]);
+					generator->ClassifyTracks();
 				} else {
 					generator->SetAnimation(animData->ToRuntime());
+					sampledAnimId.reset();
 				}
+			} else if (selectiveNodeIndex.has_value()) {
+				PushSampledChanges({ selectiveNodeIndex.value() });
 			} else {
-				std::function<std::unique_ptr<MathUtil::InterpolationSystem<RE::NiQuaternion>>()> rotInterp;
-				std::function<std::unique_ptr<MathUtil::InterpolationSystem<RE::NiPoint3>>()> posInterp;
+				auto [rotInterp, posInterp] = GetInterpCreators();
+				generator->SetAnimation(animData->ToRuntimeSampled(rotInterp, posInterp));
+				sampledAnimId = generator->animationId;
+			}
+		}
 
-				switch (rotInterpType) {
-				case kSquad:
-					rotInterp = []() { return std::make_unique<MathUtil::QuatSquadSpline>(); };
-					break;
-				case kCatmullRom:
-					rotInterp = []() { return std::make_unique<MathUtil::QuatCatmullRomSpline>(); };
-					break;
-				case kNaturalCubic:
-					rotInterp = []() { return std::make_unique<MathUtil::QuatNaturalCubicSpline>(); };
-					break;
-				default:
-					rotInterp = []() { return std::make_unique<MathUtil::QuatLinear>(); };
-					break;
-				}
+		//Refits & resamples only the given timelines, as long as the generator still holds the result of the last full sampled push.
+		void PushSampledChanges(std::vector<size_t> nodeIndices) {
+			if (!sampledAnimId.has_value() ||
+				!generator->HasAnimation() ||
+				generator->animationId != *sampledAnimId ||
+				generator->animData->timelines.size() != animData->timelines.size() ||
+				generator->animData->duration != animData->GetRuntimeDuration() - animData->sampleRate)
+			{
+				PushDataToGenerator(true);
+				return;
+			}
 
-				switch (posInterpType) {
-				case kNaturalCubic:
-					posInterp = []() { return std::make_unique<MathUtil::Pt3NaturalCubicSpline>(); };
-					break;
-				default:
-					posInterp = []() { return std::make_unique<MathUtil::Pt3Linear>(); };
-					break;
-				}
+			std::sort(nodeIndices.begin(), nodeIndices.end());
+			nodeIndices.erase(std::unique(nodeIndices.begin(), nodeIndices.end()), nodeIndices.end());
+
+			auto [rotInterp, posInterp] = GetInterpCreators();
+			animData->UpdateRuntimeSampled(generator->animData.get(), nodeIndices, rotInterp, posInterp);
+			generator->ClassifyTracks();
+		}
+
+		std::pair<FrameBasedNodeAnimation::RotInterpCreator, FrameBasedNodeAnimation::PosInterpCreator> GetInterpCreators() {
+			FrameBasedNodeAnimation::RotInterpCreator rotInterp;
+			FrameBasedNodeAnimation::PosInterpCreator posInterp;
+
+			switch (rotInterpType) {
+			case kSquad:
+				rotInterp = []() { return std::make_unique<MathUtil::QuatSquadSpline>(); };
+				break;
+			case kCatmullRom:
+				rotInterp = []() { return std::make_unique<MathUtil::QuatCatmullRomSpline>(); };
+				break;
+			case kNaturalCubic:
+				rotInterp = []() { return std::make_unique<MathUtil::QuatNaturalCubicSpline>(); };
+				break;
+			default:
+				rotInterp = []() { return std::make_unique<MathUtil::QuatLinear>(); };
+				break;
+			}
 
-				generator->SetAnimation(animData->ToRuntimeSampled(rotInterp, posInterp));
+			switch (posInterpType) {
+			case kNaturalCubic:
+				posInterp = []() { return std::make_unique<MathUtil::Pt3NaturalCubicSpline>(); };
+				break;
+			default:
+				posInterp = []() { return std::make_unique<MathUtil::Pt3Linear>(); };
+				break;
 			}
+
+			return { rotInterp, posInterp };
 		}
 
 		bool NodeValid(size_t nodeIndex) {
@@ -405,7 +524,7 @@ namespace BodyAnimation
 				keys.erase(iter);
 				EndChangeDelta();
 				EndHistoryAction();
-				PushDataToGenerator(true);
+				PushDataToGenerator(true, nodeIndex);
 			}
 		}
 
@@ -416,7 +535,7 @@ namespace BodyAnimation
 			VisitFrame(nodeIndex, frame, kDelete);
 			EndChangeDelta();
 			EndHistoryAction();
-			PushDataToGenerator(true);
+			PushDataToGenerator(true, nodeIndex);
 		}
 
 		void CopyFrame(size_t nodeIndex, size_t frame) {
@@ -436,7 +555,7 @@ namespace BodyAnimation
 				keys[target] = iter->second;
 				EndChangeDelta();
 				EndHistoryAction();
-				PushDataToGenerator(true);
+				PushDataToGenerator(true, nodeIndex);
 			}
 		}
 
@@ -495,12 +614,14 @@ namespace BodyAnimation
 			if (!undoHistory.empty()) {
 				auto& entry = undoHistory.front();
 				std::string result = entry.displayName;
+				std::vector<size_t> changedNodes;
 				for (auto& d : entry.deltas) {
 					ProcessChangeDelta(d.nodeIndex, d.frame, d.backValue);
+					changedNodes.push_back(d.nodeIndex);
 				}
 				redoHistory.push_front(entry);
 				undoHistory.pop_front();
-				PushDataToGenerator(true);
+				PushSampledChanges(std::move(changedNodes));
 				return result;
 			}
 			return std::nullopt;
@@ -510,12 +631,14 @@ namespace BodyAnimation
 			if (!redoHistory.empty()) {
 				auto& entry = redoHistory.front();
 				std::string result = entry.displayName;
+				std::vector<size_t> changedNodes;
 				for (auto& d : entry.deltas) {
 					ProcessChangeDelta(d.nodeIndex, d.frame, d.forwardValue);
+					changedNodes.push_back(d.nodeIndex);
 				}
 				undoHistory.push_front(entry);
 				redoHistory.pop_front();
-				PushDataToGenerator(true);
+				PushSampledChanges(std::move(changedNodes));
 				return result;
 			}
 			return std::nullopt;
@@ -616,9 +739,13 @@ namespace BodyAnimation
 		}
 
 		void EndIncrementalAdjust() {
+			std::optional<size_t> nodeIndex = std::nullopt;
+			if (currentDelta.has_value())
+				nodeIndex = currentDelta->nodeIndex;
+
 			EndChangeDelta();
 			EndHistoryAction();
-			PushDataToGenerator(true);
+			PushDataToGenerator(true, nodeIndex);
 		}
 	};
 }
@@ -138,6 +138,162 @@ namespace BodyAnimation
 		}
 	};
 
+	//Rotation matrices for a pose, kept between updates so only bones whose rotation changed are converted again.
+	struct PoseMatrixCache
+	{
+		//Converts the rotations of the given bones that changed since the last call, in a single batch.
+		void Update(const std::vector<NodeTransform>& pose, std::span<const uint32_t> indices) {
+			if (rotations.size() < pose.size()) {
+				rotations.resize(pose.size());
+				matrices.resize(pose.size());
+				valid.resize(pose.size(), 0);
+			}
+
+			dirty.clear();
+			dirtyRotations.clear();
+			for (const auto& i : indices) {
+				const auto& q = pose[i].rotate;
+				const auto& prev = rotations[i];
+				if (!valid[i] || q.w != prev.w || q.x != prev.x || q.y != prev.y || q.z != prev.z) {
+					dirty.push_back(i);
+					dirtyRotations.push_back(q);
+				}
+			}
+
+			if (dirty.empty())
+				return;
+
+			dirtyMatrices.resize(dirty.size());
+			MathUtil::QuatsToRotations(dirtyRotations, dirtyMatrices);
+			for (size_t k = 0; k < dirty.size(); k++) {
+				const auto i = dirty[k];
+				rotations[i] = dirtyRotations[k];
+				matrices[i] = dirtyMatrices[k];
+				valid[i] = 1;
+			}
+		}
+
+		const RE::NiMatrix3& operator[](size_t i) const {
+			return matrices[i];
+		}
+
+	private:
+		std::vector<RE::NiQuaternion> rotations;
+		std::vector<RE::NiMatrix3> matrices;
+		std::vector<uint8_t> valid;
+		std::vector<uint32_t> dirty;
+		std::vector<RE::NiQuaternion> dirtyRotations;
+		std::vector<RE::NiMatrix3> dirtyMatrices;
+	};
+
+	//Drops keys that can be reconstructed by interpolating their neighbours, within a position & rotation error bound.
+	struct KeyReduction
+	{
+		struct Tolerance
+		{
+			float position = 0.05f;
+			//Radians.
+			float rotation = 0.0035f;
+		};
+
+		Tolerance defaultTolerance;
+		std::unordered_map<std::string, Tolerance> nodeTolerances;
+
+		const Tolerance& GetTolerance(const std::string& nodeName) const {
+			if (auto iter = nodeTolerances.find(nodeName); iter != nodeTolerances.end()) {
+				return iter->second;
+			}
+			return defaultTolerance;
+		}
+
+		static std::optional<KeyReduction> FromSettings() {
+			if (!Data::Settings::Values.bReduceAnimationKeys)
+				return std::nullopt;
+
+			KeyReduction result;
+			result.defaultTolerance.position = Data::Settings::Values.fKeyReductionPosTolerance;
+			result.defaultTolerance.rotation = MathUtil::DegreeToRadian(Data::Settings::Values.fKeyReductionRotTolerance);
+
+			//Per-node overrides, as a comma-separated list of Node:position:rotation entries. Rotation is in degrees.
+			const std::string nodeTols = Data::Settings::Values.sKeyReductionNodeTolerances.get();
+			for (const auto& entry : Utility::SplitString(nodeTols, ",")) {
+				const auto parts = Utility::SplitString(entry, ":");
+				if (parts.size() != 3 || parts[0].empty())
+					continue;
+
+				Tolerance t;
+				t.position = Utility::StringToFloat(parts[1]);
+				t.rotation = MathUtil::DegreeToRadian(Utility::StringToFloat(parts[2]));
+				if (t.position > 0.0f && t.rotation > 0.0f) {
+					result.nodeTolerances[std::string(parts[0])] = t;
+				}
+			}
+			return result;
+		}
+
+		//Returns the larger of the position & rotation differences between a and b, normalized to the tolerance.
+		static float GetError(const NodeTransform& a, const NodeTransform& b, const Tolerance& tol) {
+			const RE::NiPoint3 posDiff = a.translate - b.translate;
+			const float posError = std::sqrt(posDiff.x * posDiff.x + posDiff.y * posDiff.y + posDiff.z * posDiff.z) / tol.position;
+			const float dot = std::fabs(a.rotate.w * b.rotate.w + a.rotate.x * b.rotate.x + a.rotate.y * b.rotate.y + a.rotate.z * b.rotate.z);
+			const float rotError = (2.0f * std::acos(std::min(dot, 1.0f))) / tol.rotation;
+			return std::max(posError, rotError);
+		}
+
+		//Douglas-Peucker style reduction over 'count' keys, 'stride' values apart. Appends the indices of the keys to keep to keepOut, in order.
+		//The error of a dropped key is measured against linear/slerp interpolation between the kept keys, matching NodeTimeline::GetValueAtTime.
+		static void Reduce(const float* times, const NodeTransform* values, size_t stride, size_t count, const Tolerance& tol, std::vector<size_t>& keepOut) {
+			if (count < 3) {
+				for (size_t i = 0; i < count; i++) {
+					keepOut.push_back(i);
+				}
+				return;
+			}
+
+			std::vector<uint8_t> keep(count, 0);
+			keep[0] = 1;
+			keep[count - 1] = 1;
+
+			std::vector<std::pair<size_t, size_t>> segments;
+			segments.emplace_back(0, count - 1);
+			NodeTransform interp;
+
+			while (!segments.empty()) {
+				auto [first, last] = segments.back();
+				segments.pop_back();
+				if (last - first < 2)
+					continue;
+
+				const auto& a = values[first * stride];
+				const auto& b = values[last * stride];
+				const float span = times[last] - times[first];
+				size_t worstIdx = first;
+				float worstError = 0.0f;
+
+				for (size_t k = first + 1; k < last; k++) {
+					interp.Lerp(a, b, span > 0.0f ? (times[k] - times[first]) / span : 0.0f);
+					const float error = GetError(interp, values[k * stride], tol);
+					if (error > worstError) {
+						worstError = error;
+						worstIdx = k;
+					}
+				}
+
+				//Errors are normalized to their tolerance, so anything above 1 is out of bounds.
+				if (worstError > 1.0f) {
+					keep[worstIdx] = 1;
+					segments.emplace_back(first, worstIdx);
+					segments.emplace_back(worstIdx, last);
+				}
+			}
+
+			for (size_t i = 0; i < count; i++) {
+				if (keep[i])
+					keepOut.push_back(i);
+			}
+		}
+	};
+
 	struct NodeKeyframe
 	{
 		NodeTransform value;
@@ -148,11 +304,202 @@ namespace BodyAnimation
 		}
 	};
 
+	//Compact playback-only copy of a NodeTimeline's keys, decoded on the fly while sampling.
+	//Times are 16-bit steps of the track's length, rotations are smallest-three quaternions packed into 48 bits,
+	//and translations are 16 bits per component across the track's bounds. 14 bytes per key, versus 32 bytes + a map node.
+	struct QuantizedNodeTimeline
+	{
+		using PackedValue = std::array<uint16_t, 3>;
+
+		//Maximum decoding error accepted at conversion time, tighter than key reduction since it applies to every key.
+		inline static constexpr KeyReduction::Tolerance maxError{ 0.01f, 0.002f };
+
+		float timeStep = 0.0f;
+		RE::NiPoint3 posMin;
+		RE::NiPoint3 posStep;
+		std::vector<uint16_t> frames;
+		std::vector<PackedValue> rotations;
+		std::vector<PackedValue> positions;
+		size_t cachedIdx = 0;
+
+		bool empty() const {
+			return frames.empty();
+		}
+
+		void clear() {
+			frames.clear();
+			rotations.clear();
+			positions.clear();
+			cachedIdx = 0;
+		}
+
+		float GetTime(size_t idx) const {
+			return static_cast<float>(frames[idx]) * timeStep;
+		}
+
+		void GetKey(size_t idx, NodeTransform& out) const {
+			DecodeRotation(rotations[idx], out.rotate);
+			const auto& p = positions[idx];
+			out.translate.x = posMin.x + static_cast<float>(p[0]) * posStep.x;
+			out.translate.y = posMin.y + static_cast<float>(p[1]) * posStep.y;
+			out.translate.z = posMin.z + static_cast<float>(p[2]) * posStep.z;
+		}
+
+		//Returns false, leaving out empty, if the keys can't be represented within maxError.
+		static bool Encode(const std::map<float, NodeKeyframe>& keys, QuantizedNodeTimeline& out) {
+			out.clear();
+			if (keys.empty() || keys.size() > UINT16_MAX + 1 || keys.begin()->first < 0.0f)
+				return false;
+
+			const float lastTime = std::prev(keys.end())->first;
+			out.timeStep = lastTime > 0.0f ? lastTime / static_cast<float>(UINT16_MAX) : 1.0f;
+
+			RE::NiPoint3 posMax = keys.begin()->second.value.translate;
+			out.posMin = posMax;
+			for (const auto& k : keys) {
+				const auto& t = k.second.value.translate;
+				out.posMin = { std::min(out.posMin.x, t.x), std::min(out.posMin.y, t.y), std::min(out.posMin.z, t.z) };
+				posMax = { std::max(posMax.x, t.x), std::max(posMax.y, t.y), std::max(posMax.z, t.z) };
+			}
+			out.posStep = {
+				(posMax.x - out.posMin.x) / static_cast<float>(UINT16_MAX),
+				(posMax.y - out.posMin.y) / static_cast<float>(UINT16_MAX),
+				(posMax.z - out.posMin.z) / static_cast<float>(UINT16_MAX)
+			};
+
+			auto quantizePos = [&](float v, float min, float step) -> uint16_t {
+				return step > 0.0f ? static_cast<uint16_t>(std::clamp(std::round((v - min) / step), 0.0f, static_cast<float>(UINT16_MAX))) : 0;
+			};
+
+			out.frames.reserve(keys.size());
+			out.rotations.reserve(keys.size());
+			out.positions.reserve(keys.size());
+			NodeTransform decoded;
+			for (const auto& k : keys) {
+				const auto& v = k.second.value;
+				const uint16_t frame = static_cast<uint16_t>(std::min(std::round(k.first / out.timeStep), static_cast<float>(UINT16_MAX)));
+
+				//Two keys landing on the same step would change the shape of the track.
+				if (!out.frames.empty() && frame <= out.frames.back()) {
+					out.clear();
+					return false;
+				}
+
+				out.frames.push_back(frame);
+				out.rotations.push_back(EncodeRotation(v.rotate));
+				out.positions.push_back({ quantizePos(v.translate.x, out.posMin.x, out.posStep.x),
+					quantizePos(v.translate.y, out.posMin.y, out.posStep.y),
+					quantizePos(v.translate.z, out.posMin.z, out.posStep.z) });
+
+				out.GetKey(out.frames.size() - 1, decoded);
+				if (KeyReduction::GetError(decoded, v, maxError) > 1.0f) {
+					out.clear();
+					return false;
+				}
+			}
+
+			out.frames.shrink_to_fit();
+			out.rotations.shrink_to_fit();
+			out.positions.shrink_to_fit();
+			return true;
+		}
+
+		//Same sampling behaviour as NodeTimeline::GetValueAtTime.
+		void GetValueAtTime(float t, NodeTransform& transform) {
+			const size_t count = frames.size();
+			if (count < 2 || t <= GetTime(0)) {
+				GetKey(0, transform);
+				return;
+			} else if (t >= GetTime(count - 1)) {
+				GetKey(count - 1, transform);
+				return;
+			}
+
+			//Playback usually stays within the cached segment or moves to the next one.
+			if (cachedIdx + 1 >= count || GetTime(cachedIdx) > t || GetTime(cachedIdx + 1) < t) {
+				if (cachedIdx + 2 < count && GetTime(cachedIdx + 1) <= t && GetTime(cachedIdx + 2) >= t) {
+					cachedIdx++;
+				} else {
+					const float frame = t / timeStep;
+					auto iter = std::upper_bound(frames.begin(), frames.end(), frame, [](float f, uint16_t k) { return f < static_cast<float>(k); });
+					const size_t next = std::clamp(static_cast<size_t>(std::distance(frames.begin(), iter)), static_cast<size_t>(1), count - 1);
+					cachedIdx = next - 1;
+				}
+			}
+
+			const float prevTime = GetTime(cachedIdx);
+			const float nextTime = GetTime(cachedIdx + 1);
+			if (t == prevTime) {
+				GetKey(cachedIdx, transform);
+			} else if (t == nextTime) {
+				GetKey(cachedIdx + 1, transform);
+			} else {
+				NodeTransform prev;
+				NodeTransform next;
+				GetKey(cachedIdx, prev);
+				GetKey(cachedIdx + 1, next);
+				transform.Lerp(prev, next, (t - prevTime) / (nextTime - prevTime));
+			}
+		}
+
+	private:
+		inline static constexpr float componentRange = 0.70710678f;
+		inline static constexpr float componentSteps = 32767.0f;
+
+		//Drops the largest component, which can be rebuilt from the unit length, and stores its index in the top 2 bits
+		//followed by the other three at 15 bits each.
+		static PackedValue EncodeRotation(const RE::NiQuaternion& q) {
+			float c[4] = { q.x, q.y, q.z, q.w };
+			const float len = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2] + c[3] * c[3]);
+			size_t largest = 0;
+			for (size_t i = 0; i < 4; i++) {
+				if (len > 0.0f)
+					c[i] /= len;
+				if (std::fabs(c[i]) > std::fabs(c[largest]))
+					largest = i;
+			}
+			const float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+
+			uint64_t bits = static_cast<uint64_t>(largest);
+			for (size_t i = 0; i < 4; i++) {
+				if (i == largest)
+					continue;
+				const float n = (std::clamp(c[i] * sign, -componentRange, componentRange) + componentRange) / (2.0f * componentRange);
+				bits = (bits << 15) | static_cast<uint64_t>(std::round(n * componentSteps));
+			}
+
+			return { static_cast<uint16_t>(bits >> 32), static_cast<uint16_t>(bits >> 16), static_cast<uint16_t>(bits) };
+		}
+
+		static void DecodeRotation(const PackedValue& v, RE::NiQuaternion& out) {
+			const uint64_t bits = (static_cast<uint64_t>(v[0]) << 32) | (static_cast<uint64_t>(v[1]) << 16) | static_cast<uint64_t>(v[2]);
+			const size_t largest = static_cast<size_t>((bits >> 45) & 0x3);
+			float c[4];
+			float sumSq = 0.0f;
+			int shift = 30;
+			for (size_t i = 0; i < 4; i++) {
+				if (i == largest)
+					continue;
+				const float n = static_cast<float>((bits >> shift) & 0x7FFF) / componentSteps;
+				c[i] = (n * 2.0f * componentRange) - componentRange;
+				sumSq += c[i] * c[i];
+				shift -= 15;
+			}
+			c[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSq));
+			out.x = c[0];
+			out.y = c[1];
+			out.z = c[2];
+			out.w = c[3];
+		}
+	};
+
 	struct NodeTimeline
 	{
 		std::map<float, NodeKeyframe> keys;
 		std::map<float, NodeKeyframe>::iterator cachedNextIter;
 		std::map<float, NodeKeyframe>::iterator cachedPrevIter;
+		//Runtime-only, not serialized. When set, keys is empty and sampling reads from here instead.
+		QuantizedNodeTimeline packed;
 
 		NodeTimeline()
 		{
@@ -165,6 +512,51 @@ namespace BodyAnimation
 		void Init() {
 			cachedNextIter = keys.begin();
 			cachedPrevIter = keys.begin();
+			packed.cachedIdx = 0;
+		}
+
+		enum TrackType : uint8_t
+		{
+			kEmpty,
+			kConstant,
+			kAnimated
+		};
+
+		TrackType GetTrackType() const {
+			if (!packed.empty())
+				return kAnimated;
+
+			switch (keys.size()) {
+			case 0:
+				return kEmpty;
+			case 1:
+				return kConstant;
+			default:
+				return kAnimated;
+			}
+		}
+
+		//Moves the keys into a quantized representation for playback. Keeps the keys as-is if quantizing them would exceed the error bound.
+		//Tracks that never move past the error bound are collapsed to a single key instead.
+		bool Compress() {
+			if (!packed.empty() || keys.empty())
+				return false;
+
+			const auto& first = keys.begin()->second.value;
+			if (keys.size() > 1 && std::all_of(std::next(keys.begin()), keys.end(), [&](const auto& k) {
+					return KeyReduction::GetError(first, k.second.value, QuantizedNodeTimeline::maxError) <= 1.0f;
+				})) {
+				keys.erase(std::next(keys.begin()), keys.end());
+				Init();
+				return true;
+			}
+
+			if (!QuantizedNodeTimeline::Encode(keys, packed))
+				return false;
+
+			keys.clear();
+			Init();
+			return true;
 		}
 
 		template <class Archive>
@@ -195,6 +587,11 @@ namespace BodyAnimation
 
 		void GetValueAtTime(float t, NodeTransform& transform)
 		{
+			if (!packed.empty()) {
+				packed.GetValueAtTime(t, transform);
+				return;
+			}
+
 			if (keys.size() < 1) {
 				transform.MakeIdentity();
 				return;
@@ -231,6 +628,13 @@ namespace BodyAnimation
 		float duration = 0.001f;
 		std::vector<NodeTimeline> timelines;
 
+		//Quantizes every timeline for playback. Only for animations that won't be edited afterwards.
+		void Compress() {
+			concurrency::parallel_for_each(timelines.begin(), timelines.end(), [](NodeTimeline& tl) {
+				tl.Compress();
+			});
+		}
+
 		template <class Archive>
 		void serialize(Archive& ar, const uint32_t)
 		{
@@ -255,6 +659,8 @@ namespace BodyAnimation
 		size_t duration = 2;
 		std::vector<FrameBasedNodeTimeline> timelines;
 
+		inline static std::atomic<uint64_t> nextBatchId = 1;
+
 		float GetRuntimeDuration() {
 			return static_cast<float>(duration) * sampleRate;
 		}
@@ -277,6 +683,7 @@ namespace BodyAnimation
 
 		void UpdateRuntimeSelective(size_t tlIndex, NodeTimeline& target, bool noCheck = false) {
 			if (noCheck || tlIndex < timelines.size()) {
+				target.packed.clear();
 				target.keys.clear();
 				auto& tl = timelines[tlIndex];
 				for (const auto& k : tl.keys) {
@@ -286,130 +693,194 @@ namespace BodyAnimation
 			}
 		}
 
-		std::unique_ptr<NodeAnimation> ToRuntimeSampled(
-			const std::function<std::unique_ptr<MathUtil::InterpolationSystem<RE::NiQuaternion>>()>& rotInterpCreator,
-			const std::function<std::unique_ptr<MathUtil::InterpolationSystem<RE::NiPoint3>>()>& posInterpCreator)
+		using RotInterpCreator = std::function<std::unique_ptr<MathUtil::InterpolationSystem<RE::NiQuaternion>>()>;
+		using PosInterpCreator = std::function<std::unique_ptr<MathUtil::InterpolationSystem<RE::NiPoint3>>()>;
+
+		//Per-thread scratch space for SampleTimeline. The key buffers are kept for the lifetime of the thread,
+		//and the interpolators are created once per thread for each ToRuntimeSampled/UpdateRuntimeSampled call.
+		struct SampleWorkspace
+		{
+			std::vector<float> X;
+			std::vector<RE::NiPoint3> Yp;
+			std::vector<RE::NiQuaternion> Yr;
+			std::vector<float> sampleTimes;
+			std::vector<float> clampedTimes;
+			std::vector<RE::NiPoint3> posOut;
+			std::vector<RE::NiQuaternion> rotOut;
+			std::unique_ptr<MathUtil::InterpolationSystem<RE::NiQuaternion>> rotInterp = nullptr;
+			std::unique_ptr<MathUtil::InterpolationSystem<RE::NiPoint3>> posInterp = nullptr;
+			uint64_t batchId = 0;
+		};
+
+		std::unique_ptr<NodeAnimation> ToRuntimeSampled(const RotInterpCreator& rotInterpCreator, const PosInterpCreator& posInterpCreator)
 		{
 			std::unique_ptr<NodeAnimation> result = ToRuntime();
+			const uint64_t batchId = nextBatchId++;
 
 			concurrency::parallel_for_each(result->timelines.begin(), result->timelines.end(), [&](NodeTimeline& tl) {
-				size_t s = tl.keys.size();
-				if (s < 2)
+				SampleTimeline(tl, result->duration, batchId, rotInterpCreator, posInterpCreator);
+			});
+
+			return result;
+		}
+
+		//Rebuilds & resamples only the given timelines of a target previously produced by ToRuntimeSampled.
+		//Each timeline's spline is fit independently, so the rest of the target doesn't need to be touched.
+		void UpdateRuntimeSampled(NodeAnimation* target, const std::vector<size_t>& tlIndices, const RotInterpCreator& rotInterpCreator, const PosInterpCreator& posInterpCreator)
+		{
+			const uint64_t batchId = nextBatchId++;
+			concurrency::parallel_for_each(tlIndices.begin(), tlIndices.end(), [&](size_t i) {
+				if (i >= timelines.size() || i >= target->timelines.size())
 					return;
 
-				float minT = static_cast<float>(tl.keys.begin()->first);
-				float maxT = static_cast<float>(std::prev(tl.keys.end())->first);
-				float t = 0;
-				bool doSample = true;
-
-				if (s > 2) {
-					auto rotInterp = rotInterpCreator();
-					auto posInterp = posInterpCreator();
-
-					//If the timeline has at least 3 keys, and the first & last keys are
-					//on the first and last frames, do loop smoothing.
-					//The loop is smoothed by copying the first two keys after the end,
-					//and the last two keys before the beginning, effectively shaping the
-					//spline curve for a seamless loop.
-					bool doLoopSmoothing =
-						tl.keys.begin()->first < 0.001f &&
-						std::fabs(std::prev(tl.keys.end())->first - result->duration) < 0.001f;
-
-					std::vector<float> X;
-					std::vector<RE::NiPoint3> Yp;
-					std::vector<RE::NiQuaternion> Yr;
-					X.reserve(s);
-					Yp.reserve(s);
-					Yr.reserve(s);
-
-					size_t lastIdx = 0;
-					auto addKeyData = [&](const NodeTransform& val, float t){
-						X.push_back(t);
-						Yp.push_back(val.translate);
-						RE::NiQuaternion q = val.rotate;
-						if (lastIdx > 0) {
-							const auto& q1 = Yr[lastIdx - 1];
-							const auto& q2 = q;
-							float dot = q1.w * q2.w + q1.x * q2.x + q1.y * q2.y + q1.z * q2.z;
-							if (dot < 0.0f) {
-								q = -q;
-							}
+				auto& tl = target->timelines[i];
+				UpdateRuntimeSelective(i, tl, true);
+				SampleTimeline(tl, target->duration, batchId, rotInterpCreator, posInterpCreator);
+				tl.Init();
+			});
+		}
+
+		static SampleWorkspace& GetWorkspace(uint64_t batchId, const RotInterpCreator& rotInterpCreator, const PosInterpCreator& posInterpCreator)
+		{
+			thread_local SampleWorkspace ws;
+			if (ws.batchId != batchId) {
+				ws.rotInterp = rotInterpCreator();
+				ws.posInterp = posInterpCreator();
+				ws.batchId = batchId;
+			}
+			return ws;
+		}
+
+		void SampleTimeline(NodeTimeline& tl, float runtimeDuration, uint64_t batchId, const RotInterpCreator& rotInterpCreator, const PosInterpCreator& posInterpCreator)
+		{
+			size_t s = tl.keys.size();
+			if (s < 2)
+				return;
+
+			float minT = static_cast<float>(tl.keys.begin()->first);
+			float maxT = static_cast<float>(std::prev(tl.keys.end())->first);
+			float t = 0;
+			bool doSample = true;
+
+			if (s > 2) {
+				auto& ws = GetWorkspace(batchId, rotInterpCreator, posInterpCreator);
+				auto& rotInterp = ws.rotInterp;
+				auto& posInterp = ws.posInterp;
+
+				//If the timeline has at least 3 keys, and the first & last keys are
+				//on the first and last frames, do loop smoothing.
+				//The loop is smoothed by copying the first two keys after the end,
+				//and the last two keys before the beginning, effectively shaping the
+				//spline curve for a seamless loop.
+				bool doLoopSmoothing =
+					tl.keys.begin()->first < 0.001f &&
+					std::fabs(std::prev(tl.keys.end())->first - runtimeDuration) < 0.001f;
+
+				auto& X = ws.X;
+				auto& Yp = ws.Yp;
+				auto& Yr = ws.Yr;
+				X.clear();
+				Yp.clear();
+				Yr.clear();
+
+				size_t lastIdx = 0;
+				auto addKeyData = [&](const NodeTransform& val, float t){
+					X.push_back(t);
+					Yp.push_back(val.translate);
+					RE::NiQuaternion q = val.rotate;
+					if (lastIdx > 0) {
+						const auto& q1 = Yr[lastIdx - 1];
+						const auto& q2 = q;
+						float dot = q1.w * q2.w + q1.x * q2.x + q1.y * q2.y + q1.z * q2.z;
+						if (dot < 0.0f) {
+							q = -q;
 						}
-						Yr.push_back(q);
-						lastIdx++;
-					};
-
-					if (doLoopSmoothing) {
-						auto secondToLast = std::prev(std::prev(tl.keys.end()));
-						auto thirdToLast = std::prev(secondToLast);
-
-						float timeDiff = 0 - (result->duration - thirdToLast->first);
-						addKeyData(thirdToLast->second.value, timeDiff);
-						timeDiff = 0 - (result->duration - secondToLast->first);
-						addKeyData(secondToLast->second.value, timeDiff);
 					}
+					Yr.push_back(q);
+					lastIdx++;
+				};
+
+				if (doLoopSmoothing) {
+					auto secondToLast = std::prev(std::prev(tl.keys.end()));
+					auto thirdToLast = std::prev(secondToLast);
+
+					float timeDiff = 0 - (runtimeDuration - thirdToLast->first);
+					addKeyData(thirdToLast->second.value, timeDiff);
+					timeDiff = 0 - (runtimeDuration - secondToLast->first);
+					addKeyData(secondToLast->second.value, timeDiff);
+				}
 
-					for (auto& k : tl.keys) {
-						addKeyData(k.second.value, k.first);
-					}
+				for (auto& k : tl.keys) {
+					addKeyData(k.second.value, k.first);
+				}
 
-					if (doLoopSmoothing) {
-						auto secondToFirst = std::next(tl.keys.begin());
-						auto thirdToFirst = std::next(secondToFirst);
+				if (doLoopSmoothing) {
+					auto secondToFirst = std::next(tl.keys.begin());
+					auto thirdToFirst = std::next(secondToFirst);
 
-						float timeDiff = result->duration + secondToFirst->first;
-						addKeyData(secondToFirst->second.value, timeDiff);
-						timeDiff = result->duration + thirdToFirst->first;
-						addKeyData(thirdToFirst->second.value, timeDiff);
+					float timeDiff = runtimeDuration + secondToFirst->first;
+					addKeyData(secondToFirst->second.value, timeDiff);
+					timeDiff = runtimeDuration + thirdToFirst->first;
+					addKeyData(thirdToFirst->second.value, timeDiff);
+				}
+
+				posInterp->SetData(X, Yp);
+				rotInterp->SetData(X, Yr);
+
+				auto& sampleTimes = ws.sampleTimes;
+				auto& clampedTimes = ws.clampedTimes;
+				sampleTimes.clear();
+				clampedTimes.clear();
+				while (doSample) {
+					if (t >= runtimeDuration) {
+						t = runtimeDuration;
+						doSample = false;
 					}
+					sampleTimes.push_back(t);
+					clampedTimes.push_back(std::clamp(t, minT, maxT));
 
-					posInterp->SetData(X, Yp);
-					rotInterp->SetData(X, Yr);
+					t += sampleRate;
+				}
 
-					tl.keys.clear();
-					while(doSample) {
-						if (t >= result->duration) {
-							t = result->duration;
-							doSample = false;
-						}
-						auto& val = tl.keys[t].value;
-						float clampedT = std::clamp(t, minT, maxT);
-						val.translate = (*posInterp)(clampedT);
-						val.rotate = (*rotInterp)(clampedT);
+				ws.posOut.resize(clampedTimes.size());
+				ws.rotOut.resize(clampedTimes.size());
+				posInterp->Evaluate(clampedTimes, ws.posOut);
+				rotInterp->Evaluate(clampedTimes, ws.rotOut);
 
-						t += sampleRate;
+				tl.keys.clear();
+				for (size_t i = 0; i < sampleTimes.size(); i++) {
+					auto& val = tl.keys.emplace_hint(tl.keys.end(), sampleTimes[i], NodeKeyframe{})->second.value;
+					val.translate = ws.posOut[i];
+					val.rotate = ws.rotOut[i];
+				}
+			} else {
+				//If the timeline only has 2 keys, fall back to normal cubic easing.
+				auto first = *tl.keys.begin();
+				auto second = *std::next(tl.keys.begin());
+				tl.keys.clear();
+				
+				while (doSample) {
+					if (t >= runtimeDuration) {
+						t = runtimeDuration;
+						doSample = false;
 					}
-				} else {
-					//If the timeline only has 2 keys, fall back to normal cubic easing.
-					auto first = *tl.keys.begin();
-					auto second = *std::next(tl.keys.begin());
-					tl.keys.clear();
-					
-					while (doSample) {
-						if (t >= result->duration) {
-							t = result->duration;
-							doSample = false;
-						}
-						auto& val = tl.keys[t].value;
-
-						if (t <= minT) {
-							val = first.second.value;
-						} else if (t >= maxT) {
-							val = second.second.value;
-						} else {
-							float cubicT = static_cast<float>(Easing::easeInOutCubic(MathUtil::NormalizeTime(minT, maxT, t)));
-							val.translate.x = std::lerp(first.second.value.translate.x, second.second.value.translate.x, cubicT);
-							val.translate.y = std::lerp(first.second.value.translate.y, second.second.value.translate.y, cubicT);
-							val.translate.z = std::lerp(first.second.value.translate.z, second.second.value.translate.z, cubicT);
-							NodeTransform::ShortestPathSlerp(val.rotate, first.second.value.rotate, second.second.value.rotate, cubicT);
-						}
+					auto& val = tl.keys.emplace_hint(tl.keys.end(), t, NodeKeyframe{})->second.value;
 
-						t += sampleRate;
+					if (t <= minT) {
+						val = first.second.value;
+					} else if (t >= maxT) {
+						val = second.second.value;
+					} else {
+						float cubicT = static_cast<float>(Easing::easeInOutCubic(MathUtil::NormalizeTime(minT, maxT, t)));
+						val.translate.x = std::lerp(first.second.value.translate.x, second.second.value.translate.x, cubicT);
+						val.translate.y = std::lerp(first.second.value.translate.y, second.second.value.translate.y, cubicT);
+						val.translate.z = std::lerp(first.second.value.translate.z, second.second.value.translate.z, cubicT);
+						NodeTransform::ShortestPathSlerp(val.rotate, first.second.value.rotate, second.second.value.rotate, cubicT);
 					}
-				}
-			});
 
-			return result;
+					t += sampleRate;
+				}
+			}
 		}
 
 		inline static ConversionResult FromRuntime(const NodeAnimation* a_data, float a_sampleRate = 0.033333f) {
@@ -58,6 +58,9 @@ namespace BodyAnimation
 		float transitionLocalTime = 0.0f;
 		float transitionDuration = 0.01f;
 
+		PoseMatrixCache outputMatrices;
+		std::vector<uint32_t> outputIndices;
+
 		~NodeAnimationGraph() {
 			SetDisableOCBP(false);
 
@@ -221,19 +224,57 @@ namespace BodyAnimation
 		}
 
 	private:
+		//Writes the bones in outputIndices to their nodes. The havok graph overwrites every node each frame,
+		//so all of them still have to be written, but only rotations that changed are converted to matrices.
+		void WriteOutput(const std::vector<NodeTransform>& a_output) {
+			outputMatrices.Update(a_output, outputIndices);
+			for (const auto& i : outputIndices) {
+				auto& local = nodes[i]->local;
+				local.rotate = outputMatrices[i];
+				local.translate = a_output[i].translate;
+			}
+		}
+
 		void PushOutput(const std::vector<NodeTransform>& a_output) {
 			size_t updateCount = nodes.size() > a_output.size() ? a_output.size() : nodes.size();
 
+			outputIndices.clear();
 			for (size_t i = 0; i < updateCount; i++) {
 				if (nodes[i] != nullptr && !a_output[i].IsIdentity())
-					a_output[i].ToComplex(nodes[i]->local);
+					outputIndices.push_back(static_cast<uint32_t>(i));
 			}
+			WriteOutput(a_output);
 
 			if (state == kGenerator) {
 				ikManager.Update(a_output);
 			}
 		}
 
+		//Only touches the generator's animated and constant tracks, constant ones being a plain copy.
+		void PushGeneratorOutput() {
+			const size_t count = nodes.size();
+			const auto& output = generator.output;
+
+			outputIndices.clear();
+			for (const auto& i : generator.animatedTracks) {
+				if (i < count && nodes[i] != nullptr && !output[i].IsIdentity())
+					outputIndices.push_back(i);
+			}
+			WriteOutput(output);
+
+			for (const auto& c : generator.constantTracks) {
+				if (c.index < count && nodes[c.index] != nullptr) {
+					auto& local = nodes[c.index]->local;
+					local.rotate = c.rotate;
+					local.translate = c.translate;
+				}
+			}
+
+			if (state == kGenerator) {
+				ikManager.Update(output);
+			}
+		}
+
 		bool UpdateGenerator(float deltaTime, bool output = false) {
 			if (!generator.HasAnimation()) {
 				state = kIdle;
@@ -242,7 +283,7 @@ namespace BodyAnimation
 
 			generator.Update(deltaTime);
 			if (output) {
-				PushOutput(generator.output);
+				PushGeneratorOutput();
 			}
 
 			return true;
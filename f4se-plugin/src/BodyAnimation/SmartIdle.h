@@ -104,6 +104,20 @@ namespace BodyAnimation
 			return true;
 		}
 
+		//Sets the function called each time the actor's animation loops. Returns false if NAF isn't animating the actor,
+		//in which case Havok is, and loops can only be found by checking the graph time.
+		static bool SetLoopListener(RE::Actor* a, std::function<void()> listener)
+		{
+			if (!a)
+				return false;
+
+			return BodyAnimation::GraphHook::VisitGraph(
+				a, [&](NodeAnimationGraph* g) {
+					g->generator.loopListener = std::move(listener);
+				},
+				false, true);
+		}
+
 		static bool SetGraphTime(RE::Actor* a, float t)
 		{
 			if (!a)
@@ -79,13 +79,13 @@ namespace CamHook
 		public:
 			InputListener()
 			{
-				RegisterListener(Data::Events::HUD_E_KEY_DOWN, &InputListener::OnHudKey);
-				RegisterListener(Data::Events::HUD_Q_KEY_DOWN, &InputListener::OnHudKey);
-				RegisterListener(Data::Events::HUD_E_KEY_UP, &InputListener::OnHudKey);
-				RegisterListener(Data::Events::HUD_Q_KEY_UP, &InputListener::OnHudKey);
+				RegisterListener<Data::Events::HUD_E_KEY_DOWN>(&InputListener::OnHudKey);
+				RegisterListener<Data::Events::HUD_Q_KEY_DOWN>(&InputListener::OnHudKey);
+				RegisterListener<Data::Events::HUD_E_KEY_UP>(&InputListener::OnHudKey);
+				RegisterListener<Data::Events::HUD_Q_KEY_UP>(&InputListener::OnHudKey);
 			}
 
-			void OnHudKey(Data::Events::event_type a_key, Data::Events::EventData&)
+			void OnHudKey(Data::Events::event_type a_key, const Data::Events::NoData&)
 			{
 				switch (a_key) {
 				case Data::Events::HUD_E_KEY_DOWN:
@@ -106,6 +106,7 @@ namespace CamHook
 			}
 
 			~InputListener() {
+				UnregisterAllListeners();
 				pendingInput = 0;
 			}
 		};
@@ -229,7 +230,7 @@ namespace CamHook
 		}
 	}
 
-	void OnSettingsChanged(Data::Events::event_type, Data::Events::EventData&)
+	void OnSettingsChanged(Data::Events::event_type, const Data::Events::NoData&)
 	{
 		std::unique_lock l{ detail::lock };
 		if (detail::active && !detail::UpdateLookAtNode()) {
@@ -238,7 +239,7 @@ namespace CamHook
 	}
 
 	inline static bool settingsListenerRegistered = ([]() {
-		Data::Events::Subscribe(Data::Events::SETTINGS_CHANGED, &OnSettingsChanged);
+		Data::Events::Subscribe<Data::Events::SETTINGS_CHANGED>(&OnSettingsChanged);
 		return true;
 	})();
 
@@ -1,8 +1,16 @@
 #pragma once
 #include <any>
 
+namespace Scene
+{
+	enum SyncState : uint8_t;
+}
+
 namespace Data
 {
+	template <uint16_t E>
+	struct EventPayload;
+
 	class Events
 	{
 	public:
@@ -34,9 +42,12 @@ namespace Data
 			HUD_Q_KEY_UP,
 			HUD_E_KEY_DOWN,
 			HUD_E_KEY_UP,
-			SETTINGS_CHANGED
+			SETTINGS_CHANGED,
+			EVENT_TYPE_COUNT
 		};
 
+		using NoData = std::monostate;
+
 		struct SceneData
 		{
 			uint64_t id;
@@ -55,50 +66,378 @@ namespace Data
 			std::string treeId;
 		};
 
+		template <event_type E>
+		using Payload = typename EventPayload<E>::type;
+
 		typedef std::any EventData;
 		typedef std::function<void(event_type, EventData&)> EventFunctor;
-		typedef std::list<EventFunctor>::iterator EventRegistration;
 
-		static EventRegistration Subscribe(event_type evnt, EventFunctor receiver) {
-			std::unique_lock l{ lock };
-			registrations[evnt].push_back(receiver);
-			return --registrations[evnt].end();
+		struct EventRegistration
+		{
+			event_type evnt = EVENT_TYPE_COUNT;
+			uint64_t id = 0;
+		};
+
+		// Typed subscribers receive the payload directly. Subscribers registered through the EventData overload
+		// only have the payload wrapped in a std::any if at least one of them is listening for that event.
+		template <event_type E, typename F>
+		static EventRegistration Subscribe(F receiver)
+		{
+			static_assert(E < EVENT_TYPE_COUNT);
+			auto s = std::make_unique<Subscriber>();
+			s->receiver = [receiver = std::move(receiver)](event_type evnt, const void* data) {
+				receiver(evnt, *static_cast<const Payload<E>*>(data));
+			};
+			return AddSubscriber(E, std::move(s));
 		}
 
-		static void Unsubscribe(event_type evnt, EventRegistration reg)
+		static EventRegistration Subscribe(event_type evnt, EventFunctor receiver)
 		{
-			std::unique_lock l{ lock };
-			if (registrations.contains(evnt)) {
-				for (auto iter = registrations[evnt].begin(); iter != registrations[evnt].end();) {
-					if (std::addressof(*iter) == std::addressof(*reg)) {
-						iter = registrations[evnt].erase(iter);
-						break;
-					} else {
-						iter++;
+			if (evnt >= EVENT_TYPE_COUNT)
+				return {};
+
+			auto s = std::make_unique<Subscriber>();
+			s->erasedReceiver = std::move(receiver);
+			return AddSubscriber(evnt, std::move(s));
+		}
+
+		// Once this returns, the subscriber won't be called again & any calls to it in progress on other threads have finished.
+		// Calls further up the calling thread's own stack (a subscriber unsubscribing itself) can't finish first, so they aren't waited for.
+		static void Unsubscribe(const EventRegistration& reg)
+		{
+			if (reg.evnt >= EVENT_TYPE_COUNT)
+				return;
+
+			const Subscriber* target = nullptr;
+			{
+				std::unique_lock l{ writeLock };
+				auto iter = subscribers.find(reg.id);
+				if (iter == subscribers.end() || iter->second->evnt != reg.evnt)
+					return;
+
+				auto& current = lists[reg.evnt];
+				std::unique_ptr<SubscriberList> next;
+				if (current->size() > 1) {
+					next = std::make_unique<SubscriberList>();
+					next->reserve(current->size() - 1);
+					for (auto s : *current) {
+						if (s != iter->second.get())
+							next->push_back(s);
+					}
+				}
+
+				target = iter->second.get();
+				iter->second->removed.store(true, std::memory_order_relaxed);
+				channels[reg.evnt].store(next.get(), std::memory_order_release);
+				Retire(std::move(current), std::move(iter->second));
+				current = std::move(next);
+				subscribers.erase(iter);
+			}
+
+			//Senders publish the subscriber they're calling, then check if it was removed, with no fence in between.
+			//Flushing every core's write buffer here means a sender either sees the removal, or its call is seen below.
+			FlushProcessWriteBuffers();
+			const SenderState* self = &ThisSender();
+			for (auto st = senders.load(std::memory_order_acquire); st != nullptr; st = st->next) {
+				if (st == self)
+					continue;
+
+				for (auto& c : st->calling) {
+					while (c.load(std::memory_order_acquire) == target) {
+						std::this_thread::yield();
 					}
 				}
 			}
 		}
 
-		static void SendMutable(event_type evnt, EventData& data)
+		// Subscribers are called synchronously, on the sending thread. The subscriber list is an immutable snapshot,
+		// so subscribers may freely subscribe or unsubscribe while being called. Senders never lock & only write to their own thread's state.
+		template <event_type E>
+		static void Send(const Payload<E>& data = {})
 		{
-			std::unique_lock l{ lock };
-			if (registrations.contains(evnt)) {
-				for (auto& f : registrations[evnt]) {
-					f(evnt, data);
+			static_assert(E < EVENT_TYPE_COUNT);
+			if (channels[E].load(std::memory_order_acquire) == nullptr)
+				return;
+
+			SenderState& st = ThisSender();
+			if (st.depth >= SenderState::kMaxDepth) {
+				//Only this many nested sends are tracked. Anything deeper is almost certainly a feedback loop, so it's left for the next frame.
+				Post<E>(data);
+				return;
+			}
+
+			SendScope scope{ st };
+			const auto subs = channels[E].load(std::memory_order_acquire);
+			if (subs == nullptr)
+				return;
+
+			auto& calling = st.calling[scope.depth];
+			std::optional<EventData> erasedData;
+			for (const auto s : *subs) {
+				//A snapshot can still hold a subscriber that was unsubscribed after it was taken.
+				calling.store(s, std::memory_order_relaxed);
+				std::atomic_signal_fence(std::memory_order_seq_cst);
+				if (!s->removed.load(std::memory_order_relaxed)) {
+					if (s->receiver) {
+						s->receiver(E, &data);
+					} else {
+						if (!erasedData.has_value())
+							erasedData.emplace(data);
+						s->erasedReceiver(E, erasedData.value());
+					}
 				}
+				calling.store(nullptr, std::memory_order_release);
 			}
 		}
 
-		static void Send(event_type evnt, const EventData& data = false) {
-			EventData e = data;
-			SendMutable(evnt, e);
+		// Queues the event to be sent from the game loop on the next frame, instead of from the calling thread.
+		template <event_type E>
+		static void Post(Payload<E> data = {})
+		{
+			static_assert(E < EVENT_TYPE_COUNT);
+			if (channels[E].load(std::memory_order_acquire) == nullptr)
+				return;
+
+			std::unique_lock l{ deferredLock };
+			deferredEvents.emplace_back([data = std::move(data)]() {
+				Send<E>(data);
+			});
+		}
+
+		// Called once per frame from the game loop. Also frees subscriber lists & subscribers that no sender can still be reading.
+		static void DispatchDeferred()
+		{
+			ReclaimRetired();
+
+			std::vector<std::function<void()>> pending;
+			{
+				std::unique_lock l{ deferredLock };
+				if (deferredEvents.empty())
+					return;
+				std::swap(pending, deferredEvents);
+			}
+
+			for (auto& f : pending) {
+				f();
+			}
 		}
+
 	private:
-		inline static std::unordered_map<event_type, std::list<EventFunctor>> registrations;
-		inline static safe_mutex lock;
+		struct Subscriber
+		{
+			event_type evnt = EVENT_TYPE_COUNT;
+			std::function<void(event_type, const void*)> receiver;
+			EventFunctor erasedReceiver;
+			std::atomic<bool> removed = false;
+		};
+
+		using SubscriberList = std::vector<const Subscriber*>;
+
+		// Per-thread sending state, only written by its own thread. Records are never freed, a thread that exits
+		// releases its record for the next new thread to reuse.
+		struct SenderState
+		{
+			static constexpr uint32_t kMaxDepth = 8;
+
+			//The reclaim epoch as of when the outermost send on this thread started, 0 while it isn't sending.
+			std::atomic<uint64_t> epoch = 0;
+			//The subscriber being called at each level of nested sends.
+			std::array<std::atomic<const Subscriber*>, kMaxDepth> calling{};
+			std::atomic<bool> inUse = true;
+			uint32_t depth = 0;
+			SenderState* next = nullptr;
+		};
+
+		struct SenderHandle
+		{
+			SenderState* state;
+
+			~SenderHandle()
+			{
+				state->inUse.store(false, std::memory_order_release);
+			}
+		};
+
+		// Marks a send as in progress on this thread. Like Unsubscribe, ReclaimRetired flushes write buffers
+		// before reading the epoch, so publishing it doesn't need a fence.
+		struct SendScope
+		{
+			SenderState& st;
+			uint32_t depth;
+
+			SendScope(SenderState& s) :
+				st(s), depth(s.depth++)
+			{
+				if (depth == 0) {
+					st.epoch.store(reclaimEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+					std::atomic_signal_fence(std::memory_order_seq_cst);
+				}
+			}
+
+			~SendScope()
+			{
+				if (--st.depth == 0)
+					st.epoch.store(0, std::memory_order_release);
+			}
+		};
+
+		// A subscriber list or subscriber that was replaced at reclaimEpoch 'epoch', & may still be read by sends that started before then.
+		struct Retired
+		{
+			uint64_t epoch;
+			std::unique_ptr<const SubscriberList> list;
+			std::unique_ptr<Subscriber> subscriber;
+		};
+
+		static SenderState& ThisSender()
+		{
+			thread_local SenderHandle handle{ AcquireSenderState() };
+			return *handle.state;
+		}
+
+		static SenderState* AcquireSenderState()
+		{
+			for (auto st = senders.load(std::memory_order_acquire); st != nullptr; st = st->next) {
+				bool expected = false;
+				if (!st->inUse.load(std::memory_order_relaxed) && st->inUse.compare_exchange_strong(expected, true))
+					return st;
+			}
+
+			auto st = new SenderState();
+			st->next = senders.load(std::memory_order_relaxed);
+			while (!senders.compare_exchange_weak(st->next, st)) {}
+			return st;
+		}
+
+		static EventRegistration AddSubscriber(event_type evnt, std::unique_ptr<Subscriber> s)
+		{
+			std::unique_lock l{ writeLock };
+			auto& current = lists[evnt];
+			auto next = current ? std::make_unique<SubscriberList>(*current) : std::make_unique<SubscriberList>();
+			next->push_back(s.get());
+
+			s->evnt = evnt;
+			EventRegistration result{ evnt, ++nextId };
+			subscribers.emplace(result.id, std::move(s));
+
+			channels[evnt].store(next.get(), std::memory_order_release);
+			Retire(std::move(current), nullptr);
+			current = std::move(next);
+			return result;
+		}
+
+		// Must be called with writeLock held.
+		static void Retire(std::unique_ptr<const SubscriberList> list, std::unique_ptr<Subscriber> subscriber)
+		{
+			if (list == nullptr && subscriber == nullptr)
+				return;
+
+			retired.push_back({ reclaimEpoch.load(std::memory_order_relaxed), std::move(list), std::move(subscriber) });
+			hasRetired.store(true, std::memory_order_relaxed);
+		}
+
+		static void ReclaimRetired()
+		{
+			if (!hasRetired.load(std::memory_order_relaxed))
+				return;
+
+			reclaimEpoch.fetch_add(1);
+			FlushProcessWriteBuffers();
+
+			uint64_t oldest = UINT64_MAX;
+			for (auto st = senders.load(std::memory_order_acquire); st != nullptr; st = st->next) {
+				if (auto e = st->epoch.load(std::memory_order_acquire); e != 0)
+					oldest = std::min(oldest, e);
+			}
+
+			std::vector<Retired> freeable;
+			{
+				std::unique_lock l{ writeLock };
+				auto firstKept = std::stable_partition(retired.begin(), retired.end(), [&](const Retired& r) { return r.epoch < oldest; });
+				freeable.insert(freeable.end(), std::make_move_iterator(retired.begin()), std::make_move_iterator(firstKept));
+				retired.erase(retired.begin(), firstKept);
+				hasRetired.store(!retired.empty(), std::memory_order_relaxed);
+			}
+		}
+
+		inline static std::array<std::atomic<const SubscriberList*>, EVENT_TYPE_COUNT> channels{};
+		inline static std::array<std::unique_ptr<const SubscriberList>, EVENT_TYPE_COUNT> lists;
+		inline static std::unordered_map<uint64_t, std::unique_ptr<Subscriber>> subscribers;
+		inline static std::vector<Retired> retired;
+		inline static std::mutex writeLock;
+		inline static uint64_t nextId = 0;
+
+		//Starts at 1, since a sender's epoch of 0 means it isn't sending.
+		inline static std::atomic<uint64_t> reclaimEpoch = 1;
+		inline static std::atomic<bool> hasRetired = false;
+		inline static std::atomic<SenderState*> senders = nullptr;
+
+		inline static std::vector<std::function<void()>> deferredEvents;
+		inline static std::mutex deferredLock;
+	};
+
+	template <uint16_t E>
+	struct EventPayload
+	{
+		using type = Events::NoData;
+	};
+
+	template <>
+	struct EventPayload<Events::SCENE_START>
+	{
+		using type = uint64_t;
 	};
 
+	template <>
+	struct EventPayload<Events::SCENE_FAILED>
+	{
+		using type = uint64_t;
+	};
+
+	template <>
+	struct EventPayload<Events::SCENE_END>
+	{
+		using type = Events::SceneData;
+	};
+
+	template <>
+	struct EventPayload<Events::SCENE_POS_CHANGE>
+	{
+		using type = Events::ScenePositionData;
+	};
+
+	template <>
+	struct EventPayload<Events::TREE_POS_CHANGE>
+	{
+		using type = Events::TreePositionData;
+	};
+
+	template <>
+	struct EventPayload<Events::SCENE_SPEED_CHANGE>
+	{
+		using type = std::pair<uint64_t, float>;
+	};
+
+	template <>
+	struct EventPayload<Events::SCENE_SYNC_STATUS_CHANGE>
+	{
+		using type = std::pair<uint64_t, Scene::SyncState>;
+	};
+
+	template <>
+	struct EventPayload<Events::SCENE_ANIM_LOOP>
+	{
+		using type = uint64_t;
+	};
+
+	template <>
+	struct EventPayload<Events::SCENE_ANIM_CHANGE>
+	{
+		using type = std::pair<uint64_t, std::string>;
+	};
+
+	//Registrations are released by the base destructor, which runs after the derived class' members are gone.
+	//Derived classes whose receivers touch their own members should call UnregisterAllListeners() in their destructor.
 	template <typename T>
 	class EventListener
 	{
@@ -106,19 +445,28 @@ namespace Data
 		struct RegContainer
 		{
 			Events::EventRegistration reg;
-			Events::event_type evnt;
 
 			~RegContainer() {
-				Events::Unsubscribe(evnt, reg);
+				Events::Unsubscribe(reg);
 			}
 		};
 
+		template <Events::event_type E, typename F>
+		void RegisterListener(F receiver)
+		{
+			std::unique_lock l{ eventRegistrationlock };
+			auto container = std::make_unique<RegContainer>();
+			container->reg = Events::Subscribe<E>([receiver = receiver, inst = static_cast<T*>(this)](Events::event_type evnt, const Events::Payload<E>& data) {
+				(inst->*receiver)(evnt, data);
+			});
+			eventRegistrations[E].push_back(std::move(container));
+		}
+
 		template <typename F>
 		void RegisterListener(Events::event_type evnt, F receiver)
 		{
 			std::unique_lock l{ eventRegistrationlock };
 			auto container = std::make_unique<RegContainer>();
-			container->evnt = evnt;
 			container->reg = Events::Subscribe(evnt, Events::EventFunctor(std::bind(receiver, static_cast<T*>(this), std::placeholders::_1, std::placeholders::_2)));
 			eventRegistrations[evnt].push_back(std::move(container));
 		}
@@ -129,6 +477,11 @@ namespace Data
 				eventRegistrations.erase(evnt);
 			}
 		}
+
+		void UnregisterAllListeners() {
+			std::unique_lock l{ eventRegistrationlock };
+			eventRegistrations.clear();
+		}
 	protected:
 		std::unordered_map<Events::event_type, std::vector<std::unique_ptr<RegContainer>>> eventRegistrations;
 		safe_mutex eventRegistrationlock;
@@ -59,6 +59,7 @@ namespace Data
 #include "Data/User/Position.h"
 #include "Data/User/Race.h"
 #include "Data/User/FaceAnim.h"
+#include "Data/PositionIndex.h"
 #include <shared_mutex>
 #include "BodyAnimation/NodeAnimationData.h"
 #include "BodyAnimation/NANIM.h"
@@ -122,15 +123,9 @@ namespace Data
 			const std::unordered_set<std::string> locSet(locations.begin(), locations.end());
 
 			for (auto& loc : locSet) {
-				auto furn = Furnitures.get_ptr(loc);
-				if (furn != nullptr) {
-					for (auto& form : furn->forms) {
-						result.forms.insert(form.get());
-					}
-					for (auto& kw : furn->keywords) {
-						if (auto kwForm = RE::TESForm::GetFormByEditorID<RE::BGSKeyword>(kw); kwForm != nullptr)
-							result.keywords.insert(kwForm);
-					}
+				if (auto iter = positionIndex.furnitureGroups.find(loc); iter != positionIndex.furnitureGroups.end()) {
+					result.forms.insert(iter->second.forms.begin(), iter->second.forms.end());
+					result.keywords.insert(iter->second.keywords.begin(), iter->second.keywords.end());
 				}
 			}
 			return result;
@@ -146,29 +141,6 @@ namespace Data
 				requireTags = { require.begin(), require.end() };
 			}
 
-			bool operator()(const std::set<std::string>& compare) const {
-				for (const auto& s : excludeTags) {
-					if (compare.contains(s))
-						return false;
-				}
-
-				for (const auto& s : requireTags) {
-					if (!compare.contains(s))
-						return false;
-				}
-
-				if (includeTags.size() > 0) {
-					for (const auto& s : includeTags) {
-						if (compare.contains(s)) {
-							return true;
-						}
-					}
-					return false;
-				}
-				
-				return true;
-			}
-
 			std::vector<std::string> includeTags;
 			std::vector<std::string> excludeTags;
 			std::vector<std::string> requireTags;
@@ -181,86 +153,31 @@ namespace Data
 			std::unique_lock _l{ reloadLock };
 
 			std::vector<std::string> filteredPositions;
-			std::unordered_set<std::string> locations;
-
-			if (furnRefr != nullptr) {
-				RE::TESBoundObject* targetObj = furnRefr->data.objectReference;
-
-				for (auto& f : Furnitures) {
-					bool found = false;
-					for (auto& obj : f.second.second->forms) {
-						if (obj.get() == targetObj) {
-							locations.insert(f.first);
-							found = true;
-							break;
-						}
-					}
-					if (!found) {
-						for (auto& kw : f.second.second->keywords) {
-							auto kwForm = RE::TESForm::GetFormByEditorID<RE::BGSKeyword>(kw);
-							if (kwForm != nullptr && furnRefr->HasKeyword(kwForm)) {
-								locations.insert(f.first);
-								break;
-							}
-						}
-					}
-				}
-			}
-
+			const std::unordered_set<std::string> locations = positionIndex.GetLocations(furnRefr);
 			bool doLocFilter = locations.size() > 0;
 
-			AnimationFilter::InfoMap filterResult;
-			std::vector<size_t> anyIndices;
-			for (auto& pBase : Positions) {
-				auto& p = pBase.second;
-				if (excludeHidden && p.second->hidden) {
+			const auto& matches = positionIndex.GetMatches(filter);
+			std::vector<uint32_t> tagMatches;
+			std::span<const uint32_t> candidates = matches;
+			if (filterTags.has_value()) {
+				const auto& t = filterTags.value();
+				positionIndex.FilterByTags(positionIndex.CompileTags(t.includeTags, t.excludeTags, t.requireTags), matches, tagMatches);
+				candidates = tagMatches;
+			}
+
+			for (const auto& i : candidates) {
+				const auto& p = positionIndex.entries[i].position;
+				if (excludeHidden && p->hidden) {
 					continue;
 				}
-				if ((doLocFilter && (p.second->locations.empty() || !Utility::SetContainsAnyInVector(p.second->locations, locations)))
-					|| (!doLocFilter && !outputLocations && !p.second->locations.empty()) ) {
+				if ((doLocFilter && (p->locations.empty() || !Utility::SetContainsAnyInVector(p->locations, locations))) || (!doLocFilter && !outputLocations && !p->locations.empty())) {
 					continue;
 				}
-				auto a = p.second->GetBaseAnimation();
-				if (a->slots.size() == filter.numTotalActors) {
-					filter.CopyToMap(filterResult);
-					anyIndices.clear();
-					bool match = true;
-
-					for (size_t i = 0; i < a->slots.size(); i++) {
-						const auto& s = a->slots[i];
-						if (s.gender != Any) {
-							const auto it = filterResult.find(s.rootBehavior);
-							if (it == filterResult.end() || !it->second.SubtractGender(s.gender)) {
-								match = false;
-								break;
-							}
-						} else {
-							anyIndices.push_back(i);
-						}
-					}
-
-					if (match) {
-						for (const auto& i : anyIndices) {
-							const auto& s = a->slots[i];
-							const auto it = filterResult.find(s.rootBehavior);
-							if (it == filterResult.end() || !it->second.SubtractGender(s.gender)) {
-								match = false;
-								break;
-							}
-						}
-					}
-
-					if (match) {
-						if (filterTags.has_value() && !filterTags.value()(p.second->tags)) {
-							continue;
-						}
-						if (!outputLocations) {
-							filteredPositions.push_back(p.second->id);
-						} else if (!p.second->locations.empty()) {
-							for (auto& i : p.second->locations) {
-								filteredPositions.push_back(i);
-							}
-						}
+				if (!outputLocations) {
+					filteredPositions.push_back(p->id);
+				} else if (!p->locations.empty()) {
+					for (auto& l : p->locations) {
+						filteredPositions.push_back(l);
 					}
 				}
 			}
@@ -343,6 +260,7 @@ namespace Data
 		}
 
 		inline static safe_mutex reloadLock;
+		inline static PositionIndex positionIndex;
 
 		static void HotReload(bool rebuildFiles = true)
 		{
@@ -369,6 +287,7 @@ namespace Data
 			PositionTrees.clear();
 			GraphInfos.clear();
 			FaceAnim::nextFileId = 0;
+			TagRegistry::Clear();
 			Init(false);
 			LinkDataReferences(false);
 			logger::info("Finished rebuilding in {:.0f}ms", Utility::QueryPerfCounterTime(timer));
@@ -549,14 +468,14 @@ namespace Data
 				}
 			}
 
-			//Link Condition skeletons to root behaviors.
+			//Link Condition skeletons to root behaviors & resolve their forms.
 
 			for (auto& m : MorphSets) {
-				m.second.second->morphs.SkeletonToRootBehavior(skeletonProjectMap);
+				m.second.second->morphs.Link(skeletonProjectMap);
 			}
 
 			for (auto& e : EquipmentSets) {
-				e.second.second->datas.SkeletonToRootBehavior(skeletonProjectMap);
+				e.second.second->datas.Link(skeletonProjectMap);
 			}
 
 			//Link any LinkableForms
@@ -633,12 +552,16 @@ namespace Data
 					continue;
 
 				if (d.second.replace)
-					p->tags.clear();
+					p->ClearTags();
 
 				p->Merge(d.second);
 			}
 
 			TagData::Datas.clear();
+
+			//Build position query index.
+
+			positionIndex.Build(Positions, Furnitures);
 		}
 	};
 
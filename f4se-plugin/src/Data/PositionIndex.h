@@ -0,0 +1,271 @@
+#pragma once
+
+namespace Data
+{
+	//Query index for Global::GetFilteredPositions, rebuilt whenever data references are linked.
+	//Positions are bucketed by actor count and reduced to a per-skeleton slot signature, so checking
+	//whether a position fits a set of actors doesn't require resolving its base animation or copying
+	//the filter's InfoMap. Matches for a given actor composition are cached until the next rebuild.
+	class PositionIndex
+	{
+	public:
+		struct SlotGroup
+		{
+			std::string rootBehavior;
+			uint32_t maleCount = 0;
+			uint32_t femaleCount = 0;
+			uint32_t anyCount = 0;
+		};
+
+		struct Entry
+		{
+			std::shared_ptr<const Position> position;
+			std::vector<SlotGroup> slotGroups;
+		};
+
+		//Bitmask form of a tag filter, one bit per interned tag.
+		struct TagMask
+		{
+			std::vector<uint64_t> include;
+			std::vector<uint64_t> exclude;
+			std::vector<uint64_t> require;
+			bool hasInclude = false;
+			bool unsatisfiable = false;
+		};
+
+		struct FurnitureGroup
+		{
+			std::vector<RE::TESBoundObject*> forms;
+			std::vector<RE::BGSKeyword*> keywords;
+		};
+
+		template <typename PositionMap, typename FurnitureMap>
+		void Build(PositionMap& positions, FurnitureMap& furnitures)
+		{
+			Clear();
+			tagWords = (TagRegistry::Size() + TagSet::WordBits - 1) / TagSet::WordBits;
+
+			for (auto& pBase : positions) {
+				auto& p = pBase.second.second;
+				auto a = p->GetBaseAnimation();
+				if (a == nullptr)
+					continue;
+
+				Entry e;
+				e.position = p;
+				for (const auto& s : a->slots) {
+					auto iter = std::find_if(e.slotGroups.begin(), e.slotGroups.end(), [&](const SlotGroup& g) { return g.rootBehavior == s.rootBehavior; });
+					if (iter == e.slotGroups.end()) {
+						iter = e.slotGroups.insert(e.slotGroups.end(), SlotGroup{ s.rootBehavior });
+					}
+
+					switch (s.gender) {
+					case ActorGender::Male:
+						iter->maleCount++;
+						break;
+					case ActorGender::Female:
+						iter->femaleCount++;
+						break;
+					default:
+						iter->anyCount++;
+						break;
+					}
+				}
+
+				actorCountBuckets[static_cast<uint32_t>(a->slots.size())].push_back(static_cast<uint32_t>(entries.size()));
+				tagRows.resize(tagRows.size() + tagWords);
+				p->tagBits.CopyTo(tagRows.data() + tagRows.size() - tagWords, tagWords);
+				entries.push_back(std::move(e));
+			}
+
+			for (auto& f : furnitures) {
+				auto& group = furnitureGroups[f.first];
+				for (auto& form : f.second.second->forms) {
+					if (auto obj = form.get(false); obj != nullptr) {
+						group.forms.push_back(obj);
+						formLocations[obj].push_back(f.first);
+					}
+				}
+				for (auto& kw : f.second.second->keywords) {
+					if (auto kwForm = RE::TESForm::GetFormByEditorID<RE::BGSKeyword>(kw); kwForm != nullptr) {
+						group.keywords.push_back(kwForm);
+						keywordLocations[kwForm].push_back(f.first);
+					}
+				}
+			}
+		}
+
+		void Clear()
+		{
+			entries.clear();
+			tagRows.clear();
+			tagWords = 0;
+			actorCountBuckets.clear();
+			compositionCache.clear();
+			furnitureGroups.clear();
+			formLocations.clear();
+			keywordLocations.clear();
+		}
+
+		//Returns the indices of all entries whose slots can be filled by the actors in the filter.
+		const std::vector<uint32_t>& GetMatches(const AnimationFilter& filter)
+		{
+			std::string key = GetCompositionKey(filter);
+			if (auto iter = compositionCache.find(key); iter != compositionCache.end()) {
+				return iter->second;
+			}
+
+			auto& result = compositionCache[key];
+			if (auto bucket = actorCountBuckets.find(filter.numTotalActors); bucket != actorCountBuckets.end()) {
+				for (const auto& i : bucket->second) {
+					if (Matches(entries[i], filter.iMap)) {
+						result.push_back(i);
+					}
+				}
+			}
+			return result;
+		}
+
+		TagMask CompileTags(const std::vector<std::string>& include, const std::vector<std::string>& exclude, const std::vector<std::string>& require) const
+		{
+			TagMask result;
+			result.include.resize(tagWords, 0);
+			result.exclude.resize(tagWords, 0);
+			result.require.resize(tagWords, 0);
+
+			auto getId = [&](const std::string& tag) -> std::optional<uint32_t> {
+				auto id = TagRegistry::Find(tag);
+				if (id.has_value() && id.value() < tagWords * TagSet::WordBits)
+					return id;
+				return std::nullopt;
+			};
+			auto setBit = [](std::vector<uint64_t>& mask, uint32_t id) {
+				mask[id / TagSet::WordBits] |= (1ull << (id % TagSet::WordBits));
+			};
+
+			//Unknown tags can't be present on any position, so excluding them is a no-op and requiring them matches nothing.
+			for (const auto& t : exclude) {
+				if (auto id = getId(t); id.has_value())
+					setBit(result.exclude, id.value());
+			}
+
+			for (const auto& t : require) {
+				if (auto id = getId(t); id.has_value()) {
+					setBit(result.require, id.value());
+				} else {
+					result.unsatisfiable = true;
+				}
+			}
+
+			if (!include.empty()) {
+				result.hasInclude = true;
+				bool anyKnown = false;
+				for (const auto& t : include) {
+					if (auto id = getId(t); id.has_value()) {
+						setBit(result.include, id.value());
+						anyKnown = true;
+					}
+				}
+				if (!anyKnown)
+					result.unsatisfiable = true;
+			}
+
+			return result;
+		}
+
+		//Appends every candidate whose tags pass the mask to out, in candidate order.
+		void FilterByTags(const TagMask& mask, std::span<const uint32_t> candidates, std::vector<uint32_t>& out) const
+		{
+			if (mask.unsatisfiable)
+				return;
+
+			out.reserve(out.size() + candidates.size());
+			const uint64_t* inc = mask.include.data();
+			const uint64_t* exc = mask.exclude.data();
+			const uint64_t* req = mask.require.data();
+
+			for (const auto& i : candidates) {
+				const uint64_t* row = tagRows.data() + (static_cast<size_t>(i) * tagWords);
+				uint64_t excluded = 0;
+				uint64_t missing = 0;
+				uint64_t included = 0;
+				for (size_t w = 0; w < tagWords; w++) {
+					excluded |= row[w] & exc[w];
+					missing |= req[w] & ~row[w];
+					included |= row[w] & inc[w];
+				}
+
+				if (excluded == 0 && missing == 0 && (!mask.hasInclude || included != 0)) {
+					out.push_back(i);
+				}
+			}
+		}
+
+		std::unordered_set<std::string> GetLocations(RE::TESObjectREFR* refr) const
+		{
+			std::unordered_set<std::string> result;
+			if (!refr)
+				return result;
+
+			if (auto iter = formLocations.find(refr->data.objectReference); iter != formLocations.end()) {
+				result.insert(iter->second.begin(), iter->second.end());
+			}
+
+			for (const auto& kw : keywordLocations) {
+				if (refr->HasKeyword(kw.first)) {
+					result.insert(kw.second.begin(), kw.second.end());
+				}
+			}
+
+			return result;
+		}
+
+		std::vector<Entry> entries;
+		std::unordered_map<uint32_t, std::vector<uint32_t>> actorCountBuckets;
+		std::unordered_map<std::string, FurnitureGroup> furnitureGroups;
+
+	private:
+		//Same outcome as subtracting each slot from the filter's InfoMap: gendered slots need an actor of that gender,
+		//and non-gendered slots can take any of the remaining actors with the same root behavior.
+		static bool Matches(const Entry& e, const AnimationFilter::InfoMap& iMap)
+		{
+			for (const auto& g : e.slotGroups) {
+				const auto it = iMap.find(g.rootBehavior);
+				if (it == iMap.end())
+					return false;
+
+				const auto& info = it->second;
+				if (g.maleCount > info.maleCount || g.femaleCount > info.femaleCount)
+					return false;
+
+				uint32_t remaining = (info.maleCount - g.maleCount) + (info.femaleCount - g.femaleCount) + info.noGenderCount;
+				if (g.anyCount > remaining)
+					return false;
+			}
+			return true;
+		}
+
+		static std::string GetCompositionKey(const AnimationFilter& filter)
+		{
+			std::vector<std::pair<std::string_view, const AnimationFilter::ActorInfo*>> sorted;
+			sorted.reserve(filter.iMap.size());
+			for (const auto& i : filter.iMap) {
+				sorted.emplace_back(i.first, &i.second);
+			}
+			std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+			std::string result;
+			for (const auto& i : sorted) {
+				result += std::format("{}:{},{},{};", i.first, i.second->maleCount, i.second->femaleCount, i.second->noGenderCount);
+			}
+			return result;
+		}
+
+		//Tag bits of each entry, tagWords per row, stored contiguously in entry order.
+		std::vector<uint64_t> tagRows;
+		size_t tagWords = 0;
+		std::unordered_map<std::string, std::vector<uint32_t>> compositionCache;
+		std::unordered_map<RE::TESBoundObject*, std::vector<std::string>> formLocations;
+		std::unordered_map<RE::BGSKeyword*, std::vector<std::string>> keywordLocations;
+	};
+}
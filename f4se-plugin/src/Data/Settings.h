@@ -46,6 +46,18 @@ namespace Data
 			ThreadSafeString sHeadPartPatchTriPath = "";
 
 			std::atomic<bool> bDisableRescaler = false;
+
+			std::atomic<bool> bReduceAnimationKeys = false;
+			std::atomic<float> fKeyReductionPosTolerance = 0.05f;
+			std::atomic<float> fKeyReductionRotTolerance = 0.2f;
+			ThreadSafeString sKeyReductionNodeTolerances = "";
+
+			std::atomic<bool> bCompressCoSave = false;
+
+			std::atomic<uint32_t> iActionQueueBudgetUs = 2000;
+
+			std::atomic<uint32_t> iActiveSceneIntervalMs = 0;
+			std::atomic<uint32_t> iSettledSceneIntervalMs = 250;
 		};
 
 		struct UnsafeSettingValues
@@ -81,7 +93,7 @@ namespace Data
 			Values.iDefaultSceneDuration = a_values.iDefaultSceneDuration;
 			Values.bDisableRescaler = a_values.bDisableRescaler;
 
-			Data::Events::Send(Data::Events::SETTINGS_CHANGED);
+			Data::Events::Send<Data::Events::SETTINGS_CHANGED>();
 		}
 
 		static void Load() {
@@ -97,7 +109,7 @@ namespace Data
 					iter->second(v.second);
 			}
 
-			Data::Events::Send(Data::Events::SETTINGS_CHANGED);
+			Data::Events::Send<Data::Events::SETTINGS_CHANGED>();
 		}
 
 		static bool Save() {
@@ -113,6 +125,14 @@ namespace Data
 				{ VAR_NAME(Values.sHeadPartPatchTriPath), Values.sHeadPartPatchTriPath.get() },
 				{ VAR_NAME(Values.iDefaultSceneDuration), std::format("{}", Values.iDefaultSceneDuration.load()) },
 				{ VAR_NAME(Values.bDisableRescaler), Values.bDisableRescaler ? "true" : "false" },
+				{ VAR_NAME(Values.bReduceAnimationKeys), Values.bReduceAnimationKeys ? "true" : "false" },
+				{ VAR_NAME(Values.fKeyReductionPosTolerance), std::format("{}", Values.fKeyReductionPosTolerance.load()) },
+				{ VAR_NAME(Values.fKeyReductionRotTolerance), std::format("{}", Values.fKeyReductionRotTolerance.load()) },
+				{ VAR_NAME(Values.sKeyReductionNodeTolerances), Values.sKeyReductionNodeTolerances.get() },
+				{ VAR_NAME(Values.bCompressCoSave), Values.bCompressCoSave ? "true" : "false" },
+				{ VAR_NAME(Values.iActionQueueBudgetUs), std::format("{}", Values.iActionQueueBudgetUs.load()) },
+				{ VAR_NAME(Values.iActiveSceneIntervalMs), std::format("{}", Values.iActiveSceneIntervalMs.load()) },
+				{ VAR_NAME(Values.iSettledSceneIntervalMs), std::format("{}", Values.iSettledSceneIntervalMs.load()) },
 			};
 
 			WriteINI(file, SaveMap);
@@ -141,6 +161,16 @@ namespace Data
 			return result;
 		}
 
+		static float ParseFloat(const std::string& val, float defaultVal) {
+			float result;
+			try {
+				result = std::stof(val);
+			} catch (...) {
+				return defaultVal;
+			}
+			return result;
+		}
+
 		inline static const std::unordered_map<std::string, std::function<void(const std::string&)>> LoadMap{
 			{ VAR_NAME(Values.bUseLookAtCam), [](auto& s) { Values.bUseLookAtCam = ParseBool(s); } },
 			{ VAR_NAME(Values.sLookAtCamTarget), [](auto& s) { Values.sLookAtCamTarget = s; } },
@@ -149,6 +179,14 @@ namespace Data
 			{ VAR_NAME(Values.sHeadPartPatchTriPath), [](auto& s) { Values.sHeadPartPatchTriPath = s; } },
 			{ VAR_NAME(Values.iDefaultSceneDuration), [](auto& s) { Values.iDefaultSceneDuration = ParseU32(s, 30); } },
 			{ VAR_NAME(Values.bDisableRescaler), [](auto& s) { Values.bDisableRescaler = ParseBool(s); } },
+			{ VAR_NAME(Values.bReduceAnimationKeys), [](auto& s) { Values.bReduceAnimationKeys = ParseBool(s); } },
+			{ VAR_NAME(Values.fKeyReductionPosTolerance), [](auto& s) { Values.fKeyReductionPosTolerance = ParseFloat(s, 0.05f); } },
+			{ VAR_NAME(Values.fKeyReductionRotTolerance), [](auto& s) { Values.fKeyReductionRotTolerance = ParseFloat(s, 0.2f); } },
+			{ VAR_NAME(Values.sKeyReductionNodeTolerances), [](auto& s) { Values.sKeyReductionNodeTolerances = s; } },
+			{ VAR_NAME(Values.bCompressCoSave), [](auto& s) { Values.bCompressCoSave = ParseBool(s); } },
+			{ VAR_NAME(Values.iActionQueueBudgetUs), [](auto& s) { Values.iActionQueueBudgetUs = ParseU32(s, 2000); } },
+			{ VAR_NAME(Values.iActiveSceneIntervalMs), [](auto& s) { Values.iActiveSceneIntervalMs = ParseU32(s, 0); } },
+			{ VAR_NAME(Values.iSettledSceneIntervalMs), [](auto& s) { Values.iSettledSceneIntervalMs = ParseU32(s, 250); } },
 		};
 
 		static std::unordered_map<std::string, std::string> ParseINI(std::istream& a_stream) {
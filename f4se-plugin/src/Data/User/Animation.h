@@ -87,11 +87,13 @@ namespace Data
 				}
 			}
 
-			void Apply(RE::Actor* a, Scene::ActorPropertyMap& m) const {
+			void Apply(RE::Actor* a, Scene::SceneActorsMap& actors, size_t row) const {
 				if (!a) {
 					return;
 				}
 
+				auto& m = actors.GetProperties(row);
+
 				if (dynamicIdle) {
 					m[Scene::PropType::kDynIdle].value = idle[0];
 					m[Scene::PropType::kDynIdleID].value = idle[1];
@@ -108,8 +110,8 @@ namespace Data
 				OptionalSet(m, Scene::kStartEquipSet, startEquipSet);
 				OptionalSet(m, Scene::kStopEquipSet, stopEquipSet);
 				OptionalSet(m, Scene::kAction, actions);
-				OptionalSet(m, Scene::kOffset, offset);
-				OptionalSet(m, Scene::kScale, customScale);
+				actors.SetOffset(row, offset.has_value() ? std::make_optional(offset.value()) : std::nullopt);
+				actors.SetScale(row, customScale.has_value() ? std::make_optional(customScale.value()) : std::nullopt);
 			}
 
 			RE::TESIdleForm* GetIdle() const {
@@ -150,12 +152,15 @@ namespace Data
 
 		static bool SetActorInfo(Scene::SceneActorsMap& mapIn, const std::vector<Slot>& slots)
 		{
-			auto actors = Scene::GetActorsInOrder(mapIn);
-
-			for (auto& a : actors) {
+			//Pairs of each actor's row in the actors table & the actor itself.
+			std::vector<std::pair<size_t, RE::NiPointer<RE::Actor>>> actors;
+			actors.reserve(mapIn.size());
+			for (size_t i = 0; i < mapIn.size(); i++) {
+				auto a = mapIn.GetHandle(i).get();
 				if (a == nullptr) {
 					return false;
 				}
+				actors.emplace_back(i, a);
 			}
 
 			std::vector<size_t> anyIndices;
@@ -165,11 +170,11 @@ namespace Data
 				//First try to fill all gendered slots to avoid incorrectly placing a gendered actor into a non-gendered slot.
 				if (s.gender != ActorGender::Any) {
 					for (auto it = actors.begin(); it != actors.end(); it++) {
-						ActorGender g = ActorSexToGender((*it)->GetSex());
+						ActorGender g = ActorSexToGender(it->second->GetSex());
 
 						//If this actor has the same root behavior & gender as the corresponding slot, fill in the slot info for this actor.
-						if (s.rootBehavior == (*it)->race->behaviorGraphProjectName[0] && (g == s.gender)) {
-							s.Apply(it->get(), mapIn[it->get()->GetActorHandle()]);
+						if (s.rootBehavior == it->second->race->behaviorGraphProjectName[0] && (g == s.gender)) {
+							s.Apply(it->second.get(), mapIn, it->first);
 							//Remove actor from the temporary vector once its map info has been filled in.
 							it = actors.erase(it);
 							break;
@@ -186,8 +191,8 @@ namespace Data
 				auto& s = slots[i];
 
 				for (auto it = actors.begin(); it != actors.end(); it++) {
-					if (s.rootBehavior == (*it)->race->behaviorGraphProjectName[0]) {
-						s.Apply(it->get(), mapIn[it->get()->GetActorHandle()]);
+					if (s.rootBehavior == it->second->race->behaviorGraphProjectName[0]) {
+						s.Apply(it->second.get(), mapIn, it->first);
 						it = actors.erase(it);
 						break;
 					}
@@ -5,6 +5,16 @@ namespace Data
 	class Condition
 	{
 	public:
+		enum Field : uint8_t
+		{
+			kIsFemale = 1u << 0,
+			kIsPlayer = 1u << 1,
+			kName = 1u << 2,
+			kRootBehavior = 1u << 3,
+			kKeyword = 1u << 4,
+			kIsCompanion = 1u << 5
+		};
+
 		std::optional<bool> isFemale;
 		std::optional<bool> isPlayer;
 		std::optional<std::string> name;
@@ -16,6 +26,11 @@ namespace Data
 		std::optional<bool> isCompanion;
 		bool isOverride = false;
 
+		// Filled in by Compile() once game data is ready, so that IsTrue doesn't have to look anything up.
+		uint8_t fields = 0;
+		RE::BGSKeyword* keywordForm = nullptr;
+		RE::BSFixedString rootBehaviorName;
+
 		static std::string GetActorName(RE::Actor* targetActor)
 		{
 			std::string emptyName = "";
@@ -36,34 +51,63 @@ namespace Data
 			return std::string(fullName);
 		}
 
+		static std::string_view GetActorNameView(RE::Actor* targetActor)
+		{
+			auto* npc = targetActor->GetNPC();
+			if (!npc)
+				return {};
+
+			auto* fullName = npc->GetFullName();
+			if (!fullName)
+				return {};
+
+			return fullName;
+		}
+
+		void Compile()
+		{
+			fields = 0;
+			fields |= isFemale.has_value() ? kIsFemale : 0;
+			fields |= isPlayer.has_value() ? kIsPlayer : 0;
+			fields |= name.has_value() ? kName : 0;
+			fields |= rootBehavior.has_value() ? kRootBehavior : 0;
+			fields |= keyword.has_value() ? kKeyword : 0;
+			fields |= isCompanion.has_value() ? kIsCompanion : 0;
+
+			keywordForm = keyword.has_value() ? RE::TESForm::GetFormByEditorID<RE::BGSKeyword>(keyword.value()) : nullptr;
+			rootBehaviorName = rootBehavior.has_value() ? RE::BSFixedString(rootBehavior.value()) : RE::BSFixedString();
+		}
+
 		bool IsTrue(RE::Actor* a) const {
 			if (!a) {
 				return false;
 			}
 
-			if (isFemale.has_value() && (a->GetSex() == 1) != isFemale.value()) {
+			if (fields == 0) {
+				return true;
+			}
+
+			if ((fields & kIsFemale) && (a->GetSex() == 1) != isFemale.value()) {
 				return false;
 			}
 
-			if (isPlayer.has_value() && (a == RE::PlayerCharacter::GetSingleton()) != isPlayer.value()) {
+			if ((fields & kIsPlayer) && (a == RE::PlayerCharacter::GetSingleton()) != isPlayer.value()) {
 				return false;
 			}
 
-			if (name.has_value() && (GetActorName(a) == name.value()) != nameTrue) {
+			if ((fields & kName) && (GetActorNameView(a) == name.value()) != nameTrue) {
 				return false;
 			}
 
-			if (rootBehavior.has_value() && (a->race->rootBehaviorGraphName->c_str() == rootBehavior.value()) != rootBehaviorTrue) {
+			if ((fields & kRootBehavior) && (a->race->rootBehaviorGraphName[0] == rootBehaviorName) != rootBehaviorTrue) {
 				return false;
 			}
 
-			if (keyword.has_value()) {
-				if (auto kw = RE::TESForm::GetFormByEditorID<RE::BGSKeyword>(keyword.value()); (kw && a->HasKeyword(kw)) != keywordTrue) {
-					return false;
-				}
+			if ((fields & kKeyword) && (keywordForm && a->HasKeyword(keywordForm)) != keywordTrue) {
+				return false;
 			}
 
-			if (isCompanion.has_value() && a->boolFlags.any(RE::Actor::BOOL_FLAGS::kDoNotShowOnStealthMeter) != isCompanion.value()) {
+			if ((fields & kIsCompanion) && a->boolFlags.any(RE::Actor::BOOL_FLAGS::kDoNotShowOnStealthMeter) != isCompanion.value()) {
 				return false;
 			}
 
@@ -118,22 +162,21 @@ namespace Data
 	{
 		void Apply(RE::Actor* a) const
 		{
-			std::vector<size_t> passedConditions;
-			for (size_t i = 0; i < std::vector<std::pair<Condition, T>>::size(); i++) {
-				auto& data = std::vector<std::pair<Condition, T>>::at(i);
-				if (data.first.IsTrue(a)) {
-					if (!data.first.isOverride) {
-						passedConditions.push_back(i);
-					} else {
-						passedConditions = { i };
-						break;
+			//A passing override condition replaces every other condition, so look for one of those first.
+			//Conditions have no side effects, so this gives the same result without having to collect the passed ones.
+			if (hasOverrides) {
+				for (auto iter = std::vector<std::pair<Condition, T>>::begin(); iter != std::vector<std::pair<Condition, T>>::end(); iter++) {
+					if (iter->first.isOverride && iter->first.IsTrue(a)) {
+						iter->second.Apply(a);
+						return;
 					}
 				}
 			}
 
-			for (auto& i : passedConditions) {
-				auto& data = std::vector<std::pair<Condition, T>>::at(i);
-				data.second.Apply(a);
+			for (auto iter = std::vector<std::pair<Condition, T>>::begin(); iter != std::vector<std::pair<Condition, T>>::end(); iter++) {
+				if (!iter->first.isOverride && iter->first.IsTrue(a)) {
+					iter->second.Apply(a);
+				}
 			}
 		}
 
@@ -144,6 +187,16 @@ namespace Data
 			}
 		}
 
+		void Link(const SkeletonMapType& map)
+		{
+			hasOverrides = false;
+			for (auto iter = std::vector<std::pair<Condition, T>>::begin(); iter != std::vector<std::pair<Condition, T>>::end(); iter++) {
+				iter->first.SkeletonToRootBehavior(map);
+				iter->first.Compile();
+				hasOverrides = hasOverrides || iter->first.isOverride;
+			}
+		}
+
 		void ParseNodes(XMLUtil::Mapper& m) {
 			m.GetArray([&](XMLUtil::Mapper& m) {
 				std::pair<Condition, T> newPair;
@@ -156,6 +209,8 @@ namespace Data
 				return m;
 			}, "condition", "", false);
 		}
+
+		bool hasOverrides = true;
 	};
 
 	class IDCondition : public IdentifiableObject, public Condition
@@ -19,14 +19,21 @@ namespace Data
 	public:
 		void Apply(RE::Actor* a) const;
 
-		void ProcessApply(RE::Actor* a) const {
+		//Sets only the morphs whose value differs from the one LooksMenu currently has for the actor.
+		//Returns true if anything changed, in which case the actor's morphs still need to be updated.
+		bool SetChanged(RE::Actor* a) const {
 			if (!a)
-				return;
+				return false;
 
+			bool changed = false;
 			for (auto iter = std::vector<MorphPair>::begin(); iter != std::vector<MorphPair>::end(); iter++) {
-				LooksMenu::SetMorph(a, iter->name, nullptr, iter->value);
+				RE::BSFixedString name{ iter->name };
+				if (LooksMenu::GetMorph(a, name, nullptr) != iter->value) {
+					LooksMenu::SetMorph(a, name, nullptr, iter->value);
+					changed = true;
+				}
 			}
-			LooksMenu::UpdateMorphs(a);
+			return changed;
 		}
 
 		void ParseConditionNode(XMLUtil::Mapper& m) {
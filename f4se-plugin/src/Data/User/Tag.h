@@ -2,6 +2,105 @@
 
 namespace Data
 {
+	//Interns tag strings into dense IDs, so tag sets can be stored & compared as bitsets.
+	class TagRegistry
+	{
+	public:
+		static uint32_t Intern(const std::string_view& tag)
+		{
+			std::unique_lock l{ lock };
+			if (auto iter = ids.find(tag); iter != ids.end()) {
+				return iter->second;
+			}
+			uint32_t id = static_cast<uint32_t>(ids.size());
+			ids.emplace(std::string(tag), id);
+			return id;
+		}
+
+		static std::optional<uint32_t> Find(const std::string_view& tag)
+		{
+			std::unique_lock l{ lock };
+			if (auto iter = ids.find(tag); iter != ids.end()) {
+				return iter->second;
+			}
+			return std::nullopt;
+		}
+
+		static size_t Size()
+		{
+			std::unique_lock l{ lock };
+			return ids.size();
+		}
+
+		static void Clear()
+		{
+			std::unique_lock l{ lock };
+			ids.clear();
+		}
+
+	private:
+		struct StringHash
+		{
+			using is_transparent = void;
+			size_t operator()(const std::string_view& s) const { return std::hash<std::string_view>{}(s); }
+		};
+
+		inline static std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>> ids;
+		inline static std::mutex lock;
+	};
+
+	class TagSet
+	{
+	public:
+		static constexpr size_t WordBits = 64;
+
+		void set(uint32_t id)
+		{
+			size_t w = id / WordBits;
+			if (words.size() <= w) {
+				words.resize(w + 1, 0);
+			}
+			words[w] |= (1ull << (id % WordBits));
+		}
+
+		bool test(uint32_t id) const
+		{
+			size_t w = id / WordBits;
+			return w < words.size() && (words[w] & (1ull << (id % WordBits))) != 0;
+		}
+
+		bool empty() const
+		{
+			return std::all_of(words.begin(), words.end(), [](uint64_t w) { return w == 0; });
+		}
+
+		void clear()
+		{
+			words.clear();
+		}
+
+		TagSet& operator|=(const TagSet& other)
+		{
+			if (words.size() < other.words.size()) {
+				words.resize(other.words.size(), 0);
+			}
+			for (size_t i = 0; i < other.words.size(); i++) {
+				words[i] |= other.words[i];
+			}
+			return *this;
+		}
+
+		//Copies the bits into a fixed-width row, zero-padding or truncating as needed.
+		void CopyTo(uint64_t* out, size_t numWords) const
+		{
+			size_t n = std::min(numWords, words.size());
+			std::copy_n(words.begin(), n, out);
+			std::fill(out + n, out + numWords, 0);
+		}
+
+		std::vector<uint64_t> words;
+	};
+
 	class TagHolder
 	{
 	public:
@@ -12,20 +111,28 @@ namespace Data
 				Utility::TransformStringToLower(combinedTags);
 				Utility::ForEachSubstring(combinedTags, ",", [&](const std::string_view& strv) {
 					tags.emplace(strv);
+					tagBits.set(TagRegistry::Intern(strv));
 				});
 			}
 		}
 
 		void Merge(const TagHolder& other) {
 			tags.insert(other.tags.begin(), other.tags.end());
+			tagBits |= other.tagBits;
+		}
+
+		void ClearTags() {
+			tags.clear();
+			tagBits.clear();
 		}
 
 		void MergeAndClear(TagHolder& other) {
 			Merge(other);
-			other.tags.clear();
+			other.ClearTags();
 		}
 
 		std::set<std::string> tags;
+		TagSet tagBits;
 	};
 
 	class TagData : public TagHolder
@@ -48,7 +155,7 @@ namespace Data
 			ele.replace = replace;
 
 			if (replace)
-				ele.tags.clear();
+				ele.ClearTags();
 
 			ele.ParseTags(m);
 		}
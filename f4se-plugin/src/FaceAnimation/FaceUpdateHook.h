@@ -23,6 +23,8 @@ namespace FaceAnimation
 			std::optional<EyeVector> eyeOverride = std::nullopt;
 			std::optional<AnimInfo> animBackup = std::nullopt;
 			GameUtil::GraphTime syncInfoCache;
+			//Animation restored from a save, waiting for OnLoad to load its data. Not serialized.
+			std::unique_ptr<FaceAnimation> pendingAnim = nullptr;
 
 			template <class Archive>
 			void save(Archive& ar, const uint32_t) const
@@ -42,10 +44,7 @@ namespace FaceAnimation
 				if (hasAnim) {
 					auto loadedAnim = std::make_unique<FaceAnimation>();
 					ar(loadedAnim->timeElapsed, loadedAnim->loop, loadedAnim->havokSync);
-
-					if (loadedAnim->LoadData(animationId)) {
-						anim = std::move(loadedAnim);
-					}
+					pendingAnim = std::move(loadedAnim);
 				}
 			}
 		};
@@ -65,12 +64,6 @@ namespace FaceAnimation
 			void load(Archive& ar, const uint32_t)
 			{
 				ar(managedAnims);
-				for (auto& pair : managedAnims) {
-					auto d = GameUtil::GetFaceAnimData(pair.first.get().get());
-					if (d != nullptr) {
-						managedDatas[d] = pair.first;
-					}
-				}
 			}
 		};
 
@@ -291,6 +284,36 @@ namespace FaceAnimation
 			}
 		}
 
+		//Links loaded face animations to their actors' face data once the loaded state has been swapped in,
+		//and loads the animations' data in the background. Each animation resumes from its saved time once loaded.
+		void OnLoad() {
+			std::scoped_lock l{ loadingAnimsLock, stateLock };
+			for (auto& pair : state->managedAnims) {
+				auto d = GameUtil::GetFaceAnimData(pair.first.get().get());
+				if (d != nullptr) {
+					state->managedDatas[d] = pair.first;
+				}
+
+				if (pair.second.pendingAnim == nullptr)
+					continue;
+
+				loadingAnims[pair.first] = pair.second.animationId;
+				std::thread([targetActor = pair.first, inst = std::move(pair.second.pendingAnim), id = pair.second.animationId]() mutable {
+					bool successful = inst->LoadData(id);
+					std::unique_lock l{ loadingAnimsLock };
+					if (loadingAnims.contains(targetActor) && loadingAnims[targetActor] == id) {
+						loadingAnims.erase(targetActor);
+						if (successful) {
+							std::unique_lock l2{ stateLock };
+							if (auto iter = state->managedAnims.find(targetActor); iter != state->managedAnims.end() && iter->second.anim == nullptr) {
+								iter->second.anim = std::move(inst);
+							}
+						}
+					}
+				}).detach();
+			}
+		}
+
 		void Reset() {
 			std::scoped_lock l{ loadingAnimsLock, stateLock, geoCacheLock };
 			state = std::make_unique<PersistentState>();
@@ -146,6 +146,15 @@ namespace LooksMenu
 		}
 	}
 
+	float GetMorph(RE::Actor* actor, const RE::BSFixedString& morph, RE::BGSKeyword* keyword)
+	{
+		if (isInstalled && actor && detail::g_bodyMorphInterface) {
+			bool isFemale = (actor->GetSex() == 1);
+			return detail::g_bodyMorphInterface->GetMorph(actor, isFemale, morph, keyword);
+		}
+		return 0.0f;
+	}
+
 	void UpdateMorphs(RE::Actor* actor)
 	{
 		if (isInstalled && actor && detail::g_bodyMorphInterface) {
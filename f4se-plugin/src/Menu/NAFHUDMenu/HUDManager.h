@@ -425,7 +425,7 @@ namespace Menu
 			} else if(!initialized) {
 				ResyncElements();
 				initialized = true;
-				Data::Events::Send(Data::Events::HUD_INIT);
+				Data::Events::Send<Data::Events::HUD_INIT>();
 			}
 		}
 
@@ -69,43 +69,43 @@ namespace Menu
 				if (a_event->QJustPressed()) {
 					switch (a_event->GetBSButtonCode()) {
 					case RE::BS_BUTTON_CODE::kUp:
-						Data::Events::Send(Data::Events::HUD_UP_KEY_DOWN);
+						Data::Events::Send<Data::Events::HUD_UP_KEY_DOWN>();
 						break;
 					case RE::BS_BUTTON_CODE::kDown:
-						Data::Events::Send(Data::Events::HUD_DOWN_KEY_DOWN);
+						Data::Events::Send<Data::Events::HUD_DOWN_KEY_DOWN>();
 						break;
 					case RE::BS_BUTTON_CODE::kLeft:
-						Data::Events::Send(Data::Events::HUD_LEFT_KEY_DOWN);
+						Data::Events::Send<Data::Events::HUD_LEFT_KEY_DOWN>();
 						break;
 					case RE::BS_BUTTON_CODE::kRight:
-						Data::Events::Send(Data::Events::HUD_RIGHT_KEY_DOWN);
+						Data::Events::Send<Data::Events::HUD_RIGHT_KEY_DOWN>();
 						break;
 					case RE::BS_BUTTON_CODE::kQ:
-						Data::Events::Send(Data::Events::HUD_Q_KEY_DOWN);
+						Data::Events::Send<Data::Events::HUD_Q_KEY_DOWN>();
 						break;
 					case RE::BS_BUTTON_CODE::kE:
-						Data::Events::Send(Data::Events::HUD_E_KEY_DOWN);
+						Data::Events::Send<Data::Events::HUD_E_KEY_DOWN>();
 						break;
 					};
 				} else {
 					switch (a_event->GetBSButtonCode()) {
 					case RE::BS_BUTTON_CODE::kUp:
-						Data::Events::Send(Data::Events::HUD_UP_KEY_UP);
+						Data::Events::Send<Data::Events::HUD_UP_KEY_UP>();
 						break;
 					case RE::BS_BUTTON_CODE::kDown:
-						Data::Events::Send(Data::Events::HUD_DOWN_KEY_UP);
+						Data::Events::Send<Data::Events::HUD_DOWN_KEY_UP>();
 						break;
 					case RE::BS_BUTTON_CODE::kLeft:
-						Data::Events::Send(Data::Events::HUD_LEFT_KEY_UP);
+						Data::Events::Send<Data::Events::HUD_LEFT_KEY_UP>();
 						break;
 					case RE::BS_BUTTON_CODE::kRight:
-						Data::Events::Send(Data::Events::HUD_RIGHT_KEY_UP);
+						Data::Events::Send<Data::Events::HUD_RIGHT_KEY_UP>();
 						break;
 					case RE::BS_BUTTON_CODE::kQ:
-						Data::Events::Send(Data::Events::HUD_Q_KEY_UP);
+						Data::Events::Send<Data::Events::HUD_Q_KEY_UP>();
 						break;
 					case RE::BS_BUTTON_CODE::kE:
-						Data::Events::Send(Data::Events::HUD_E_KEY_UP);
+						Data::Events::Send<Data::Events::HUD_E_KEY_UP>();
 						break;
 					};
 				}
@@ -43,6 +43,13 @@ namespace Menu::NAF
 				{ "Settings", Button, Bind(&BodyCreatorHandler::GotoSettings) }
 			});
 
+			//The studio actors can't be edited until the bake has finished sampling them.
+			if (NAFStudioMenu::IsBaking()) {
+				manager->SetMenuTitle("Baking...");
+				result.push_back({ "Baking animation(s)..." });
+				return result;
+			}
+
 			switch (currentStage) {
 				case kSelectTarget:
 				{
@@ -228,18 +235,50 @@ namespace Menu::NAF
 			}
 		}
 
+		//The bake runs over several frames, so these callbacks can outlive this handler & go through the active manager instead.
+		static NAFStudioMenu::BakeProgressCallback GetBakeProgressCallback() {
+			return [lastStep = static_cast<size_t>(0)](size_t done, size_t total) mutable {
+				size_t step = total > 0 ? (done * 10) / total : 10;
+				if (step != lastStep && IStateManager::activeInstance != nullptr) {
+					IStateManager::activeInstance->ShowNotification(std::format("Baking animation(s)... {}%", step * 10), 2.0f);
+				}
+				lastStep = step;
+			};
+		}
+
+		static NAFStudioMenu::BakeCompleteCallback GetBakeCompleteCallback(const std::string& savedMsg, const std::string& failedMsg) {
+			return [savedMsg, failedMsg](const std::optional<std::string>& res) {
+				if (IStateManager::activeInstance == nullptr)
+					return;
+
+				if (res.has_value()) {
+					IStateManager::activeInstance->ShowNotification(std::format("{} {}", savedMsg, res.value()));
+				} else {
+					IStateManager::activeInstance->ShowNotification(failedMsg);
+				}
+				IStateManager::activeInstance->RefreshList(false);
+			};
+		}
+
 		void BakeAnim(int) {
-			if (auto res = NAFStudioMenu::BakeAnimation(); res.has_value()) {
-				manager->ShowNotification(std::format("Saved baked animation(s) to {}", res.value()));
-			} else {
+			if (NAFStudioMenu::IsBaking()) {
+				manager->ShowNotification("Already baking animation(s).");
+				return;
+			}
+
+			if (!NAFStudioMenu::BakeAnimation(GetBakeCompleteCallback("Saved baked animation(s) to", "Failed to save baked animation(s)."), GetBakeProgressCallback())) {
 				manager->ShowNotification("Failed to save baked animation(s).");
 			}
+			manager->RefreshList(false);
 		}
 
 		void PackageAnim(int) {
-			if (auto res = NAFStudioMenu::BakeAnimation(true, pkgId, restrictGenders, useScales); res.has_value()) {
-				manager->ShowNotification(std::format("Saved packaged animation(s) to {}", res.value()));
-			} else {
+			if (NAFStudioMenu::IsBaking()) {
+				manager->ShowNotification("Already baking animation(s).");
+				return;
+			}
+
+			if (!NAFStudioMenu::BakeAnimation(GetBakeCompleteCallback("Saved packaged animation(s) to", "Failed to save packaged animation(s)."), GetBakeProgressCallback(), true, pkgId, restrictGenders, useScales)) {
 				manager->ShowNotification("Failed to save packaged animation(s).");
 			}
 			currentStage = kManageNodes;
@@ -43,7 +43,7 @@ namespace Menu::NAF
 				return RE::BSEventNotifyControl::kContinue;
 			}
 
-			void OnGameDataReady(Data::Events::event_type, Data::Events::EventData&)
+			void OnGameDataReady(Data::Events::event_type, const Data::Events::NoData&)
 			{
 				RE::UI::GetSingleton()->RegisterSink(this);
 			}
@@ -52,7 +52,7 @@ namespace Menu::NAF
 			friend class Singleton;
 			MenuOpenCloseEventHandler()
 			{
-				RegisterListener(Data::Events::GAME_DATA_READY, &MenuOpenCloseEventHandler::OnGameDataReady);
+				RegisterListener<Data::Events::GAME_DATA_READY>(&MenuOpenCloseEventHandler::OnGameDataReady);
 			}
 		};
 
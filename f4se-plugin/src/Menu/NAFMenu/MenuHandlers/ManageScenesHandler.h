@@ -22,6 +22,7 @@ namespace Menu::NAF
 		float cachedSpeed = 0.0f;
 		std::string cachedAnimId = "N/A";
 		Scene::SyncState cachedSyncStatus = Scene::Synced;
+		std::optional<Scene::SceneManager::SceneMetrics> cachedMetrics;
 
 		std::vector<std::string> cachedPositions;
 
@@ -141,8 +142,8 @@ namespace Menu::NAF
 					Scene::SceneManager::VisitAllScenes([&](Scene::IScene* scn) {
 
 						actors.clear();
-						for (auto& a : scn->actors) {
-							actors.push_back(a.first);
+						for (auto& a : scn->actors.GetHandles()) {
+							actors.push_back(a);
 						}
 
 						result.push_back({ GetSceneName(actors), MENU_BINDING_WARG(ManageScenesHandler::SelectScene, scn->uid), false, 0, 0, 0, std::nullopt, false, nullptr,
@@ -171,6 +172,7 @@ namespace Menu::NAF
 						{ std::format("Sync Status: {}", GetSyncStateString()), std::nullopt },
 						{ "Speed (%): ", MENU_BINDING(ManageScenesHandler::AdjustSceneSpeed), true, 1, 500, static_cast<int>(cachedSpeed) },
 						{ std::format("Current Animation: {}", cachedAnimId), std::nullopt },
+						{ GetMetricsString(), std::nullopt },
 						{ "Change Position...", MENU_BINDING(ManageScenesHandler::ChangePosition) },
 						{ "Actor Inventories...", MENU_BINDING_WARG(ManageScenesHandler::GotoInventoriesMenu, selectionId) },
 						{ "Stop Scene", MENU_BINDING(ManageScenesHandler::StopScene) }						
@@ -272,6 +274,15 @@ namespace Menu::NAF
 				if (cachedAnimId.size() < 1)
 					cachedAnimId = "N/A";
 			});
+			cachedMetrics = Scene::SceneManager::GetSceneMetrics(selectionId);
+		}
+
+		std::string GetMetricsString() {
+			if (!cachedMetrics.has_value() || cachedMetrics->updates < 1)
+				return "Updates: N/A";
+
+			return std::format("Updates: {} ({:.3f}ms avg{})", cachedMetrics->updates, cachedMetrics->updateMs / cachedMetrics->updates,
+				cachedMetrics->sleeping ? ", Sleeping" : "");
 		}
 
 		std::string GetSyncStateString() {
@@ -308,8 +319,8 @@ namespace Menu::NAF
 			manager->highlightedObjects.RemoveAll();
 			if (hovered) {
 				Scene::SceneManager::VisitScene(uid, [&](Scene::IScene* scn) {
-					for (auto& h : scn->actors) {
-						manager->highlightedObjects.Add(h.first.get().get());
+					for (auto& h : scn->actors.GetHandles()) {
+						manager->highlightedObjects.Add(h.get().get());
 					}
 				});
 			}
@@ -40,81 +40,240 @@ namespace Menu
 			return studioInstance.load() != nullptr;
 		}
 
-		static std::optional<std::string> BakeAnimation(
+		struct BakeTarget
+		{
+			size_t actorIndex;
+			Graph* graph;
+			Creator::BAKE_DATA bakeData;
+			bool done = false;
+		};
+
+		//Called with the number of sampled frames completed & the total number of frames to sample, from the UI thread.
+		using BakeProgressCallback = std::function<void(size_t, size_t)>;
+		//Called with the path the animation(s) were saved to, or nullopt if the bake failed or was cancelled, from the UI thread.
+		using BakeCompleteCallback = std::function<void(const std::optional<std::string>&)>;
+
+		static bool IsBaking() {
+			auto inst = GetInstance();
+			return inst != nullptr && inst->activeBake != nullptr;
+		}
+
+		//Starts baking the studio actors' animations. Sampling is spread over the following frames (see StepBake),
+		//so the game keeps rendering & progress can be shown while it runs. Returns false if the bake couldn't be started.
+		static bool BakeAnimation(
+			const BakeCompleteCallback& completeCallback,
+			const BakeProgressCallback& progressCallback = nullptr,
 			bool doPackage = false,
 			const std::string_view& pkgId = "",
 			bool restrictGenders = true,
 			bool useScales = false)
 		{
-			std::optional<std::string> result = std::nullopt;
-			auto data = PersistentMenuState::CreatorData::GetSingleton();
-			if (auto inst = GetInstance(); inst != nullptr) {
+			auto inst = GetInstance();
+			if (inst == nullptr || inst->activeBake != nullptr)
+				return false;
 
-				std::vector<std::pair<SerializableActorHandle, Creator::BAKE_DATA>> bakeData;
-				for (const auto& hndl : inst->managedActors) {
-					BodyAnimation::GraphHook::VisitGraph(hndl.get().get(), [&](Graph* g) {
-						bakeData.emplace_back(hndl, g->creator->SetupBake());
-					});
-				}
+			auto job = std::make_unique<BakeJob>();
+			job->doPackage = doPackage;
+			job->pkgId = pkgId;
+			job->restrictGenders = restrictGenders;
+			job->useScales = useScales;
+			job->onProgress = progressCallback;
+			job->onComplete = completeCallback;
+			for (const auto& hndl : inst->managedActors) {
+				job->refs.push_back(job->actorPtrs.emplace_back(hndl.get()).get());
+			}
 
-				bool stepsLeft = true;
-				while (stepsLeft) {
-					//This is a bit ugly, but it's needed for IK targets parented to other actors.
-					for (auto& pair : bakeData) {
-						BodyAnimation::GraphHook::VisitGraph(pair.first.get().get(), [&](Graph* g) {
-							g->creator->GenerateAtTime(pair.second);
-						});
-					}
-					for (auto& pair : bakeData) {
-						BodyAnimation::GraphHook::VisitGraph(pair.first.get().get(), [&](Graph* g) {
-							g->creator->CalculateInverseKinematics();
-						});
+			BodyAnimation::GraphHook::VisitGraphs(job->refs, [&](const std::vector<Graph*>& graphs) {
+				for (size_t i = 0; i < graphs.size(); i++) {
+					if (graphs[i] != nullptr && graphs[i]->creator != nullptr) {
+						job->targets.push_back({ i, graphs[i], graphs[i]->creator->SetupBake() });
 					}
-					for (auto& pair : bakeData) {
-						BodyAnimation::GraphHook::VisitGraph(pair.first.get().get(), [&](Graph* g) {
-							g->creator->SampleAtTime(pair.second);
-						});
-					}
-					for (auto& pair : bakeData) {
-						stepsLeft = stepsLeft && pair.second.StepForward();
+				}
+
+				//Baking in parallel is only safe between actors that don't have IK targets parented to each other,
+				//so group actors by their IK target dependencies & step each group in lockstep, like a single bake.
+				job->groups = GetBakeGroups(job->targets, job->refs);
+			});
+
+			if (job->targets.empty())
+				return false;
+
+			for (auto& t : job->targets) {
+				job->totalFrames += t.bakeData.times.size();
+			}
+			inst->activeBake = std::move(job);
+			return true;
+		}
+
+		//Generates, solves & samples one frame for each target in a group which hasn't reached its own end yet.
+		//Finished targets keep being posed at their last frame, since the group's remaining IK chains can still target them.
+		//Returns the number of frames sampled.
+		static size_t StepBakeGroup(std::vector<BakeTarget>& targets, const std::vector<size_t>& group)
+		{
+			if (std::all_of(group.begin(), group.end(), [&](size_t i) { return targets[i].done; }))
+				return 0;
+
+			size_t sampled = 0;
+			for (auto& i : group) {
+				targets[i].graph->creator->GenerateAtTime(targets[i].bakeData);
+			}
+			for (auto& i : group) {
+				targets[i].graph->creator->CalculateInverseKinematics();
+			}
+			for (auto& i : group) {
+				if (!targets[i].done) {
+					targets[i].graph->creator->SampleAtTime(targets[i].bakeData);
+					targets[i].done = !targets[i].bakeData.StepForward();
+					sampled++;
+				}
+			}
+			return sampled;
+		}
+
+		//Samples as many frames of the active bake as fit in the frame budget, then writes & saves the results once every target is done.
+		void StepBake()
+		{
+			auto& job = *activeBake;
+			bool valid = true;
+			bool finished = false;
+			std::atomic<size_t> framesDone = 0;
+			auto data = PersistentMenuState::CreatorData::GetSingleton();
+			auto path = data->GetSavePath() + "_";
+			std::vector<std::pair<std::string, BodyAnimation::NANIM>> outputs;
+			std::vector<BakeWrite> writes;
+
+			//Graphs are looked up again every frame, since they're only guaranteed to stay alive while locked.
+			BodyAnimation::GraphHook::VisitGraphs(job.refs, [&](const std::vector<Graph*>& graphs) {
+				for (auto& t : job.targets) {
+					t.graph = graphs[t.actorIndex];
+					if (t.graph == nullptr || t.graph->creator == nullptr) {
+						valid = false;
+						return;
 					}
 				}
 
-				auto path = data->GetSavePath() + "_";
-				BodyAnimation::NANIM animContainer;
-
-				if (doPackage) {
-					path += "packaged.nanim";
-					animContainer.characters.animId = pkgId;
-					for (size_t i = 0; i < bakeData.size(); i++) {
-						auto& pair = bakeData[i];
-						auto& a = data->studioActors[i];
-						BodyAnimation::GraphHook::VisitGraph(pair.first.get().get(), [&](Graph* g) {
-							animContainer.SetAnimation(a.animId, g->nodeMap, pair.second.animData.get());
-						});
+				auto timer = Utility::CreatePerfCounter();
+				concurrency::parallel_for_each(job.groups.begin(), job.groups.end(), [&](const std::vector<size_t>& group) {
+					size_t sampled = 0;
+					do {
+						sampled = StepBakeGroup(job.targets, group);
+						framesDone += sampled;
+					} while (sampled > 0 && Utility::QueryPerfCounterTime(timer) < bakeFrameBudgetMs);
+				});
+
+				finished = std::all_of(job.targets.begin(), job.targets.end(), [](const BakeTarget& t) { return t.done; });
+				if (!finished)
+					return;
+
+				//The node maps & actor info are gathered while the graphs are still locked, the samples are written out afterwards.
+				if (job.doPackage) {
+					auto& [outPath, animContainer] = outputs.emplace_back(path + "packaged.nanim", BodyAnimation::NANIM{});
+					animContainer.characters.animId = job.pkgId;
+					for (auto& t : job.targets) {
+						if (t.actorIndex >= data->studioActors.size())
+							continue;
+
+						auto& a = data->studioActors[t.actorIndex];
+						writes.push_back({ 0, a.animId, t.graph->nodeMap, std::move(t.bakeData) });
 						auto& c = animContainer.characters.data.emplace_back();
 						c.animId = a.animId;
-						c.gender = restrictGenders ? static_cast<ActorGender>(a.actor->GetSex()) : ActorGender::Any;
+						c.gender = job.restrictGenders ? static_cast<ActorGender>(a.actor->GetSex()) : ActorGender::Any;
 						RE::BSFixedString behGraph;
 						a.actor->GetAnimationGraphProjectName(behGraph);
 						c.behaviorGraphProject = behGraph;
-						if (useScales) {
+						if (job.useScales) {
 							c.scale = a.actor->GetScale();
 						}
 					}
-					animContainer.SaveToFile(path);
-					result = path;
 				} else {
-					for (size_t i = 0; i < bakeData.size(); i++) {
-						auto& pair = bakeData[i];
-						auto& a = data->studioActors[i];
-						BodyAnimation::GraphHook::VisitGraph(pair.first.get().get(), [&](Graph* g) {
-							animContainer.SetAnimation("default", g->nodeMap, pair.second.animData.get());
-						});
-						animContainer.SaveToFile(std::format("{}{}.nanim", path, Utility::StringRestrictChars(a.animId, ALPHANUMERIC_UNDERSCORE_HYPHEN)));
+					for (auto& t : job.targets) {
+						if (t.actorIndex >= data->studioActors.size())
+							continue;
+
+						auto& a = data->studioActors[t.actorIndex];
+						writes.push_back({ outputs.size(), "default", t.graph->nodeMap, std::move(t.bakeData) });
+						outputs.emplace_back(std::format("{}{}.nanim", path, Utility::StringRestrictChars(a.animId, ALPHANUMERIC_UNDERSCORE_HYPHEN)), BodyAnimation::NANIM{});
 					}
-					result = (path + "*.nanim");
 				}
+			});
+
+			if (!valid) {
+				CancelBake();
+				return;
+			}
+
+			job.framesDone += framesDone;
+			if (job.onProgress != nullptr)
+				job.onProgress(std::min(job.framesDone, job.totalFrames), job.totalFrames);
+
+			if (!finished)
+				return;
+
+			std::string result = job.doPackage ? path + "packaged.nanim" : path + "*.nanim";
+			auto onComplete = std::move(job.onComplete);
+			activeBake.reset();
+
+			//Key reduction & saving are done on a separate thread, so the studio actors can keep updating in the meantime.
+			std::thread([outputs = std::move(outputs), writes = std::move(writes), result = std::move(result), onComplete = std::move(onComplete)]() mutable {
+				const auto reduction = BodyAnimation::KeyReduction::FromSettings();
+				for (auto& w : writes) {
+					w.bakeData.WriteTo(outputs[w.outputIndex].second, w.name, w.nodeMap, reduction);
+				}
+
+				concurrency::parallel_for_each(outputs.begin(), outputs.end(), [](auto& o) {
+					o.second.SaveToFile(o.first);
+				});
+
+				F4SE::GetTaskInterface()->AddUITask([result = std::move(result), onComplete = std::move(onComplete)]() {
+					if (onComplete != nullptr)
+						onComplete(result);
+				});
+			}).detach();
+		}
+
+		void CancelBake()
+		{
+			if (activeBake == nullptr)
+				return;
+
+			auto onComplete = std::move(activeBake->onComplete);
+			activeBake.reset();
+			if (onComplete != nullptr)
+				onComplete(std::nullopt);
+		}
+
+		//Groups bake targets which have IK chains targeting each other's actors, preserving the original target order within each group.
+		static std::vector<std::vector<size_t>> GetBakeGroups(const std::vector<BakeTarget>& targets, const std::vector<RE::TESObjectREFR*>& refs)
+		{
+			std::vector<size_t> groupOf(targets.size());
+			for (size_t i = 0; i < groupOf.size(); i++) {
+				groupOf[i] = i;
+			}
+			auto find = [&](size_t i) {
+				while (groupOf[i] != i) {
+					i = groupOf[i] = groupOf[groupOf[i]];
+				}
+				return i;
+			};
+
+			for (size_t i = 0; i < targets.size(); i++) {
+				for (auto& parentRef : targets[i].graph->ikManager.GetTargetParentRefs()) {
+					auto parent = parentRef.get();
+					for (size_t j = 0; j < targets.size(); j++) {
+						if (j != i && refs[targets[j].actorIndex] == parent.get()) {
+							groupOf[find(i)] = find(j);
+						}
+					}
+				}
+			}
+
+			std::vector<std::vector<size_t>> result;
+			std::unordered_map<size_t, size_t> groupIndices;
+			for (size_t i = 0; i < targets.size(); i++) {
+				auto [iter, inserted] = groupIndices.try_emplace(find(i), result.size());
+				if (inserted)
+					result.emplace_back();
+				result[iter->second].push_back(i);
 			}
 			return result;
 		}
@@ -465,6 +624,9 @@ namespace Menu
 		virtual void AdvanceMovie(float a_timeDelta, [[maybe_unused]] std::uint64_t a_time) override
 		{
 			GameMenuBase::AdvanceMovie(a_timeDelta, a_time);
+			if (activeBake != nullptr)
+				StepBake();
+
 			RE::NiPoint3 orbitTarget = { 0.0f, 0.0f, 0.0f };
 			float localTime = 0.0f;
 			VisitTargetGraph([&](Graph* g) {
@@ -483,7 +645,7 @@ namespace Menu
 				localTime = g->generator.localTime;
 			});
 			for (auto& hndl : managedActors) {
-				if (auto a = hndl.get(); a != nullptr) {
+				if (auto a = hndl.get(); a != nullptr && activeBake == nullptr) {
 					if (targetHandle.has_value() && targetHandle.value() != hndl) {
 						BodyAnimation::GraphHook::VisitGraph(a.get(), [&](Graph* g) {
 							g->generator.localTime = localTime;
@@ -551,7 +713,12 @@ namespace Menu
 
 		virtual void Call(const Params& a_params) override
 		{
-			switch ((*((std::uint32_t*)&(a_params.userData)))) {
+			const auto callId = *((std::uint32_t*)&(a_params.userData));
+			//Edits are ignored while a bake is sampling the studio actors.
+			if (activeBake != nullptr && callId != 0 && callId != 1 && callId != 4)
+				return;
+
+			switch (callId) {
 				case 0:
 				{
 					CloseMenu();
@@ -897,6 +1064,11 @@ namespace Menu
 
 		virtual void HandleEvent(const RE::ButtonEvent* a_event) override
 		{
+			//Only modifier keys are tracked while a bake is sampling the studio actors.
+			const auto buttonCode = a_event->GetBSButtonCode();
+			if (activeBake != nullptr && buttonCode != RE::BS_BUTTON_CODE::kLControl && buttonCode != RE::BS_BUTTON_CODE::kRControl)
+				return;
+
 			if (inputEventHandlingEnabled && a_event->strUserEvent != "NextFocus") {
 				switch (a_event->GetBSButtonCode()) {
 					case RE::BS_BUTTON_CODE::kTab:
@@ -1018,6 +1190,7 @@ namespace Menu
 		}
 
 		void CloseImpl() {
+			CancelBake();
 			SaveChangesImpl(true);
 			ClearTarget();
 			ClearManagedRefs();
@@ -1163,6 +1336,35 @@ namespace Menu
 
 		std::vector<SerializableActorHandle> managedActors;
 
+		struct BakeJob
+		{
+			bool doPackage = false;
+			std::string pkgId;
+			bool restrictGenders = true;
+			bool useScales = false;
+			BakeProgressCallback onProgress;
+			BakeCompleteCallback onComplete;
+			std::vector<RE::NiPointer<RE::Actor>> actorPtrs;
+			std::vector<RE::TESObjectREFR*> refs;
+			std::vector<BakeTarget> targets;
+			std::vector<std::vector<size_t>> groups;
+			size_t framesDone = 0;
+			size_t totalFrames = 0;
+		};
+
+		struct BakeWrite
+		{
+			size_t outputIndex;
+			std::string name;
+			std::vector<std::string> nodeMap;
+			Creator::BAKE_DATA bakeData;
+		};
+
+		//How long the bake may spend sampling each frame.
+		inline static constexpr double bakeFrameBudgetMs = 8.0;
+
+		std::unique_ptr<BakeJob> activeBake;
+
 		inline static std::atomic<NAFStudioMenu*> studioInstance = nullptr;
 	};
 }
@@ -14,6 +14,26 @@ public:
 		return sqrt(pow(pt2.x - pt1.x, 2) + pow(pt2.y - pt1.y, 2) + pow(pt2.z - pt1.z, 2) * 1.0);
 	}
 
+	static float GetDistanceSq(const RE::NiPoint3& pt1, const RE::NiPoint3& pt2)
+	{
+		const RE::NiPoint3 d = pt2 - pt1;
+		return d.x * d.x + d.y * d.y + d.z * d.z;
+	}
+
+	template <class T>
+	static void SortByDistance(const RE::NiPoint3& origin, std::vector<T*>& refs)
+	{
+		std::vector<std::pair<float, T*>> dists;
+		dists.reserve(refs.size());
+		for (auto& r : refs) {
+			dists.emplace_back(GetDistanceSq(origin, r->data.location), r);
+		}
+		std::sort(dists.begin(), dists.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+		for (size_t i = 0; i < refs.size(); i++) {
+			refs[i] = dists[i].second;
+		}
+	}
+
 	struct GraphTime
 	{
 		float current = 0.0f;
@@ -209,30 +229,116 @@ public:
 		return result;
 	}
 
-	// Gets all refs of type T in the currently loaded area, filtered by the 'filter' function.
-	template<class T>
-	static std::vector<T*> GetRefsInLoadedArea(const std::function<bool(T*)>& filter)
+	// Called by GraphHook's TESObjectREFR::Set3D detour. A ref only gets 3D once its cell is attached, so this keeps
+	// the loaded cell set up to date as cells load, without ever scanning the form map.
+	static void OnRef3DSet(RE::TESObjectREFR* a_ref, RE::NiAVObject* a_object)
 	{
-		std::vector<T*> result;
+		if (a_object == nullptr || a_ref->parentCell == nullptr)
+			return;
 
+		std::unique_lock l{ loadedCells.lock };
+		loadedCells.ids.insert(a_ref->parentCell->GetFormID());
+	}
+
+	// Marks the loaded cell set as maintained by OnRef3DSet. Until then, GetLoadedCells falls back to scanning the form map.
+	static void EnableLoadedCellTracking()
+	{
+		std::unique_lock l{ loadedCells.lock };
+		loadedCells.tracking = true;
+	}
+
+	// Gets all currently loaded cells. Cells that have unloaded since they were added are dropped from the set here,
+	// so the only per-call cost is one form lookup per cell in the set.
+	static std::vector<RE::TESObjectCELL*> GetLoadedCells()
+	{
+		std::vector<RE::TESObjectCELL*> result;
+		std::unique_lock l{ loadedCells.lock };
+		if (!loadedCells.tracking) {
+			l.unlock();
+			return ScanLoadedCells();
+		}
+
+		result.reserve(loadedCells.ids.size());
+		for (auto iter = loadedCells.ids.begin(); iter != loadedCells.ids.end();) {
+			auto cell = RE::TESForm::GetFormByID<RE::TESObjectCELL>(*iter);
+			if (cell != nullptr && cell->loadedData) {
+				result.push_back(cell);
+				iter++;
+			} else {
+				iter = loadedCells.ids.erase(iter);
+			}
+		}
+
+		return result;
+	}
+
+	// Finds loaded cells by scanning every form, under the global form map lock.
+	static std::vector<RE::TESObjectCELL*> ScanLoadedCells()
+	{
+		std::vector<RE::TESObjectCELL*> result;
 		const auto& [map, lock] = RE::TESForm::GetAllForms();
-		RE::BSAutoReadLock l{ lock };
-		std::mutex results_lock;
-		
+		RE::BSAutoReadLock fl{ lock };
+		std::mutex cellsLock;
+
 		concurrency::parallel_for_each(map->begin(), map->end(), [&](RE::BSTTuple<const uint32_t, RE::TESForm*> ele) {
 			RE::TESObjectCELL* cell = ele.second->As<RE::TESObjectCELL>();
-
 			if (cell && cell->loadedData) {
-				auto refs = GetRefsInCell(cell, filter);
-				std::scoped_lock lock(results_lock);
-				result.reserve(result.size() + refs.size());
-				result.insert(result.end(), refs.begin(), refs.end());
+				std::scoped_lock cl(cellsLock);
+				result.push_back(cell);
 			}
 		});
 
 		return result;
 	}
 
+	// Gets all refs of type T in the currently loaded area, filtered by the 'filter' function.
+	template<class T>
+	static std::vector<T*> GetRefsInLoadedArea(const std::function<bool(T*)>& filter)
+	{
+		std::vector<T*> result;
+
+		for (auto& cell : GetLoadedCells()) {
+			auto refs = GetRefsInCell(cell, filter);
+			result.insert(result.end(), refs.begin(), refs.end());
+		}
+
+		return result;
+	}
+
+	// Gets all refs of type T in the currently loaded area within 'radius' units of 'origin', sorted nearest first.
+	template <class T>
+	static std::vector<T*> GetRefsInRadius(const RE::NiPoint3& origin, float radius, const std::function<bool(T*)>& filter)
+	{
+		const float radiusSq = radius * radius;
+		auto result = GetRefsInLoadedArea<T>([&](T* r) {
+			return GetDistanceSq(origin, r->data.location) <= radiusSq && filter(r);
+		});
+		SortByDistance(origin, result);
+		return result;
+	}
+
+	// Gets the 'k' nearest refs of type T to 'origin' in the currently loaded area, sorted nearest first.
+	template <class T>
+	static std::vector<T*> GetNearestRefs(const RE::NiPoint3& origin, size_t k, const std::function<bool(T*)>& filter)
+	{
+		auto result = GetRefsInLoadedArea<T>(filter);
+		if (result.size() > k) {
+			std::vector<std::pair<float, T*>> dists;
+			dists.reserve(result.size());
+			for (auto& r : result) {
+				dists.emplace_back(GetDistanceSq(origin, r->data.location), r);
+			}
+			std::partial_sort(dists.begin(), dists.begin() + k, dists.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+			result.resize(k);
+			for (size_t i = 0; i < k; i++) {
+				result[i] = dists[i].second;
+			}
+		} else {
+			SortByDistance(origin, result);
+		}
+		return result;
+	}
+
 	template <typename T>
 	struct RefDistInfo
 	{
@@ -241,26 +347,33 @@ public:
 		T* ref;
 	};
 
+	// Gets up to 'maxResults' of the refs nearest to the player that pass 'filter', plus every ref in 'addToResultList',
+	// sorted nearest first with their distance in feet.
 	template <typename T>
-	static std::vector<RefDistInfo<T>> GenerateRefDistMap(std::function<bool(T*)> filter, const std::vector<T*> addToResultList = {})
+	static std::vector<RefDistInfo<T>> GenerateRefDistMap(std::function<bool(T*)> filter, const std::vector<T*> addToResultList = {}, size_t maxResults = SIZE_MAX)
 	{
 		std::vector<RefDistInfo<T>> result;
-		auto resultList = GameUtil::GetRefsInLoadedArea<T>(filter);
-		for (auto& e : addToResultList) {
-			resultList.push_back(e);
-		}
-
-		for (auto r : resultList) {
+		auto makeInfo = [](T* r) {
 			double dist = GameUtil::GetDistance(player->data.location, r->data.location);
 
 			if (dist >= 0.1)
 				dist = dist / 25.0;
 
 			auto name = r->GetDisplayFullName();
-			result.push_back({ dist, name ? std::string(name) : "", r });
+			return RefDistInfo<T>{ dist, name ? std::string(name) : "", r };
+		};
+
+		auto resultList = GameUtil::GetNearestRefs<T>(player->data.location, maxResults, filter);
+		result.reserve(resultList.size() + addToResultList.size());
+		for (auto r : resultList) {
+			result.push_back(makeInfo(r));
 		}
 
-		std::sort(result.begin(), result.end(), [](RefDistInfo<T>& a, RefDistInfo<T>& b) { return a.distance < b.distance; });
+		for (auto& e : addToResultList) {
+			auto info = makeInfo(e);
+			auto pos = std::upper_bound(result.begin(), result.end(), info.distance, [](double d, const RefDistInfo<T>& a) { return d < a.distance; });
+			result.insert(pos, std::move(info));
+		}
 
 		return result;
 	}
@@ -497,4 +610,14 @@ public:
 			targetActor->SetActorValue(*Data::Forms::AnimMultAV, mult);
 		}
 	}
+
+private:
+	struct LoadedCellSet
+	{
+		std::mutex lock;
+		bool tracking = false;
+		std::unordered_set<uint32_t> ids;
+	};
+
+	inline static LoadedCellSet loadedCells;
 };
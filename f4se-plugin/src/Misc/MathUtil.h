@@ -99,6 +99,59 @@ public:
 		return result;
 	}
 
+	//Same result as calling NiQuaternion::ToRotation on each element, but converts 4 quaternions at a time with SSE.
+	static void QuatsToRotations(std::span<const RE::NiQuaternion> quats, std::span<RE::NiMatrix3> out)
+	{
+		const size_t count = std::min(quats.size(), out.size());
+		size_t i = 0;
+
+		if (BatchRotationMatchesEngine()) {
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 two = _mm_set1_ps(2.0f);
+			const __m128 zero = _mm_setzero_ps();
+
+			for (; i + 4 <= count; i += 4) {
+				//NiQuaternion is laid out as w, x, y, z.
+				__m128 w = _mm_loadu_ps(&quats[i].w);
+				__m128 x = _mm_loadu_ps(&quats[i + 1].w);
+				__m128 y = _mm_loadu_ps(&quats[i + 2].w);
+				__m128 z = _mm_loadu_ps(&quats[i + 3].w);
+				_MM_TRANSPOSE4_PS(w, x, y, z);
+
+				const __m128 tx = _mm_mul_ps(x, two);
+				const __m128 ty = _mm_mul_ps(y, two);
+				const __m128 tz = _mm_mul_ps(z, two);
+				const __m128 twx = _mm_mul_ps(tx, w);
+				const __m128 twy = _mm_mul_ps(ty, w);
+				const __m128 twz = _mm_mul_ps(tz, w);
+				const __m128 txx = _mm_mul_ps(tx, x);
+				const __m128 txy = _mm_mul_ps(ty, x);
+				const __m128 txz = _mm_mul_ps(tz, x);
+				const __m128 tyy = _mm_mul_ps(ty, y);
+				const __m128 tyz = _mm_mul_ps(tz, y);
+				const __m128 tzz = _mm_mul_ps(tz, z);
+
+				__m128 rows[3][4] = {
+					{ _mm_sub_ps(one, _mm_add_ps(tyy, tzz)), _mm_sub_ps(txy, twz), _mm_add_ps(txz, twy), zero },
+					{ _mm_add_ps(txy, twz), _mm_sub_ps(one, _mm_add_ps(txx, tzz)), _mm_sub_ps(tyz, twx), zero },
+					{ _mm_sub_ps(txz, twy), _mm_add_ps(tyz, twx), _mm_sub_ps(one, _mm_add_ps(txx, tyy)), zero }
+				};
+
+				for (size_t r = 0; r < 3; r++) {
+					auto& row = rows[r];
+					_MM_TRANSPOSE4_PS(row[0], row[1], row[2], row[3]);
+					for (size_t k = 0; k < 4; k++) {
+						_mm_storeu_ps(out[i + k].entry[r].pt, row[k]);
+					}
+				}
+			}
+		}
+
+		for (; i < count; i++) {
+			quats[i].ToRotation(out[i]);
+		}
+	}
+
 	//Faster than 1.0f/std::sqrt(x), but only accurate to around 11 bits.
 	static float FastReverseSqrt(const float x) {
 		__m128 temp = _mm_set_ss(x);
@@ -118,6 +171,32 @@ public:
 		return result;
 	}
 
+	//The batch conversion assumes the standard Gamebryo layout, so it's checked once against the engine's own conversion.
+	static bool BatchRotationMatchesEngine()
+	{
+		static const bool result = []() {
+			const RE::NiQuaternion q = NormalizeQuat({ 0.8f, 0.1f, -0.3f, 0.5f });
+			RE::NiMatrix3 engine;
+			q.ToRotation(engine);
+
+			const float tx = q.x * 2.0f, ty = q.y * 2.0f, tz = q.z * 2.0f;
+			const float expected[3][3] = {
+				{ 1.0f - (ty * q.y + tz * q.z), ty * q.x - tz * q.w, tz * q.x + ty * q.w },
+				{ ty * q.x + tz * q.w, 1.0f - (tx * q.x + tz * q.z), tz * q.y - tx * q.w },
+				{ tz * q.x - ty * q.w, tz * q.y + tx * q.w, 1.0f - (tx * q.x + ty * q.y) }
+			};
+
+			for (size_t r = 0; r < 3; r++) {
+				for (size_t c = 0; c < 3; c++) {
+					if (std::fabs(engine.entry[r].pt[c] - expected[r][c]) > 0.0001f)
+						return false;
+				}
+			}
+			return true;
+		}();
+		return result;
+	}
+
 	static RE::NiQuaternion NormalizeQuat(const RE::NiQuaternion& q) {
 		auto rsqrt = FastReverseSqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
 		return { q.w * rsqrt, q.x * rsqrt, q.y * rsqrt, q.z * rsqrt };
@@ -209,6 +288,38 @@ public:
 		return { yaw, pitch };
 	}
 
+	//Shared by the segment-based interpolators: clamps to the first & last segments and walks forward
+	//through the rest, matching the segment each one's operator() would pick for the same time.
+	template <typename Segment, typename T, typename F>
+	static void EvaluateSegments(const std::vector<Segment>& segs, std::span<const float> times, std::span<T> out, F&& evalSegment)
+	{
+		if (segs.empty())
+			return;
+
+		const size_t count = std::min(times.size(), out.size());
+		size_t idx = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			float t = times[i];
+			const Segment* curSeg;
+
+			if (t < segs.front().startTime) {
+				curSeg = &segs.front();
+				t = curSeg->startTime;
+			} else if (t >= segs.back().endTime) {
+				curSeg = &segs.back();
+				t = curSeg->endTime;
+			} else {
+				while (idx + 1 < segs.size() && !(segs[idx].startTime <= t && segs[idx].endTime > t)) {
+					idx++;
+				}
+				curSeg = &segs[idx];
+			}
+
+			out[i] = evalSegment(*curSeg, NormalizeTime(curSeg->startTime, curSeg->endTime, t));
+		}
+	}
+
 	template <typename T>
 	class InterpolationSystem
 	{
@@ -222,6 +333,16 @@ public:
 			return {};
 		}
 
+		//Evaluates every time in times, which must be non-decreasing. Implementations walk their
+		//segments with a cursor instead of searching for each sample.
+		virtual void Evaluate(std::span<const float> times, std::span<T> out)
+		{
+			const size_t count = std::min(times.size(), out.size());
+			for (size_t i = 0; i < count; i++) {
+				out[i] = (*this)(times[i]);
+			}
+		}
+
 		virtual ~InterpolationSystem() {}
 	};
 
@@ -274,71 +395,158 @@ public:
 				};
 			}
 		}
+
+		virtual void Evaluate(std::span<const float> times, std::span<RE::NiPoint3> out)
+		{
+			if (!_X || !_Y)
+				return InterpolationSystem::Evaluate(times, out);
+
+			auto& X = *_X;
+			auto& Y = *_Y;
+			const size_t count = std::min(times.size(), out.size());
+			size_t idx = 0;
+
+			for (size_t i = 0; i < count; i++) {
+				const float t = times[i];
+				while (idx < X.size() && X[idx] < t) {
+					idx++;
+				}
+
+				if (idx == X.size()) {
+					out[i] = Y.back();
+				} else if (idx == 0) {
+					out[i] = Y.front();
+				} else {
+					float normalizedT = NormalizeTime(X[idx - 1], X[idx], t);
+					const auto& first = Y[idx - 1];
+					const auto& second = Y[idx];
+					out[i] = {
+						std::lerp(first.x, second.x, normalizedT),
+						std::lerp(first.y, second.y, normalizedT),
+						std::lerp(first.z, second.z, normalizedT),
+					};
+				}
+			}
+		}
 	};
 
+	//Fits x, y & z together in a single pass, with the same result as 3 tk::spline cubic hermite fits
+	//with zero first derivative boundaries. Coefficient storage is kept between SetData calls.
 	class Pt3NaturalCubicSpline : public InterpolationSystem<RE::NiPoint3>
 	{
 	public:
 		virtual ~Pt3NaturalCubicSpline() {}
 
-		std::unique_ptr<tk::spline> implX = nullptr;
-		std::unique_ptr<tk::spline> implY = nullptr;
-		std::unique_ptr<tk::spline> implZ = nullptr;
+		struct Knot
+		{
+			double x;
+			double y[3];
+			double b[3];
+			double c[3];
+			double d[3];
+		};
+
+		std::vector<Knot> knots;
 
 		virtual void SetData(const std::vector<float>& X, const std::vector<RE::NiPoint3>& Y)
 		{
 			if (Y.size() < 2 || Y.size() != X.size())
 				return;
 
-			std::vector<double> Yx, Yy, Yz, Xd;
-			Yx.reserve(Y.size());
-			Yy.reserve(Y.size());
-			Yz.reserve(Y.size());
-			Xd.reserve(Y.size());
+			const size_t n = Y.size();
+			knots.resize(n);
+			for (size_t i = 0; i < n; i++) {
+				auto& k = knots[i];
+				k.x = X[i];
+				k.y[0] = Y[i].x;
+				k.y[1] = Y[i].y;
+				k.y[2] = Y[i].z;
+			}
 
-			for (auto& p : Y) {
-				Yx.push_back(p.x);
-				Yy.push_back(p.y);
-				Yz.push_back(p.z);
+			//First derivatives from 3-point finite differences, with the end points fixed at 0.
+			for (size_t j = 0; j < 3; j++) {
+				knots[0].b[j] = 0.0;
+				knots[n - 1].b[j] = 0.0;
+				knots[n - 1].c[j] = 0.0;
+				knots[n - 1].d[j] = 0.0;
 			}
 
-			for (auto& i : X) {
-				Xd.push_back(i);
+			for (size_t i = 1; i < n - 1; i++) {
+				const double h = knots[i + 1].x - knots[i].x;
+				const double hl = knots[i].x - knots[i - 1].x;
+				const double w0 = -h / (hl * (hl + h));
+				const double w1 = (h - hl) / (hl * h);
+				const double w2 = hl / (h * (hl + h));
+				for (size_t j = 0; j < 3; j++) {
+					knots[i].b[j] = w0 * knots[i - 1].y[j] + w1 * knots[i].y[j] + w2 * knots[i + 1].y[j];
+				}
 			}
 
-			implX = std::make_unique<tk::spline>(Xd, Yx, tk::spline::cspline_hermite,
-				false,
-				tk::spline::first_deriv,
-				0.0,
-				tk::spline::first_deriv,
-				0.0);
-			implY = std::make_unique<tk::spline>(Xd, Yy, tk::spline::cspline_hermite,
-				false,
-				tk::spline::first_deriv,
-				0.0,
-				tk::spline::first_deriv,
-				0.0);
-			implZ = std::make_unique<tk::spline>(Xd, Yz, tk::spline::cspline_hermite,
-				false,
-				tk::spline::first_deriv,
-				0.0,
-				tk::spline::first_deriv,
-				0.0);
+			for (size_t i = 0; i < n - 1; i++) {
+				auto& k = knots[i];
+				const auto& next = knots[i + 1];
+				const double h = next.x - k.x;
+				for (size_t j = 0; j < 3; j++) {
+					k.c[j] = (3.0 * (next.y[j] - k.y[j]) / h - (2.0 * k.b[j] + next.b[j])) / h;
+					k.d[j] = ((next.b[j] - k.b[j]) / (3.0 * h) - 2.0 / 3.0 * k.c[j]) / h;
+				}
+			}
 		}
 
 		virtual RE::NiPoint3 operator()(float t)
 		{
-			if (!implX || !implY || !implZ)
+			if (knots.empty())
 				return {};
 
-			auto& X = *implX;
-			auto& Y = *implY;
-			auto& Z = *implZ;
+			//Both boundaries have a zero first derivative, so extrapolation is constant.
+			const double x = t;
+			if (x <= knots.front().x) {
+				return EvaluateKnot(knots.front(), knots.front().x);
+			} else if (x >= knots.back().x) {
+				return EvaluateKnot(knots.back(), knots.back().x);
+			}
+
+			auto iter = std::upper_bound(knots.begin(), knots.end(), x, [](double v, const Knot& k) { return v < k.x; });
+			return EvaluateKnot(*std::prev(iter), x);
+		}
+
+		virtual void Evaluate(std::span<const float> times, std::span<RE::NiPoint3> out)
+		{
+			if (knots.empty())
+				return InterpolationSystem::Evaluate(times, out);
+
+			const size_t count = std::min(times.size(), out.size());
+			size_t idx = 0;
+
+			for (size_t i = 0; i < count; i++) {
+				const double x = times[i];
+				while (idx + 1 < knots.size() && knots[idx + 1].x <= x) {
+					idx++;
+				}
+
+				if (x <= knots.front().x) {
+					out[i] = EvaluateKnot(knots.front(), knots.front().x);
+				} else if (x >= knots.back().x) {
+					out[i] = EvaluateKnot(knots.back(), knots.back().x);
+				} else {
+					out[i] = EvaluateKnot(knots[idx], x);
+				}
+			}
+		}
+
+	private:
+		static RE::NiPoint3 EvaluateKnot(const Knot& k, double x)
+		{
+			const double h = x - k.x;
+			double result[3];
+			for (size_t j = 0; j < 3; j++) {
+				result[j] = ((k.d[j] * h + k.c[j]) * h + k.b[j]) * h + k.y[j];
+			}
 
 			return {
-				static_cast<float>(X(t)),
-				static_cast<float>(Y(t)),
-				static_cast<float>(Z(t))
+				static_cast<float>(result[0]),
+				static_cast<float>(result[1]),
+				static_cast<float>(result[2])
 			};
 		}
 	};
@@ -388,6 +596,32 @@ public:
 				return result;
 			}
 		}
+
+		virtual void Evaluate(std::span<const float> times, std::span<RE::NiQuaternion> out)
+		{
+			if (!_X || !_Y)
+				return InterpolationSystem::Evaluate(times, out);
+
+			auto& X = *_X;
+			auto& Y = *_Y;
+			const size_t count = std::min(times.size(), out.size());
+			size_t idx = 0;
+
+			for (size_t i = 0; i < count; i++) {
+				const float t = times[i];
+				while (idx < X.size() && X[idx] < t) {
+					idx++;
+				}
+
+				if (idx == X.size()) {
+					out[i] = Y.back();
+				} else if (idx == 0) {
+					out[i] = Y.front();
+				} else {
+					out[i].Slerp(NormalizeTime(X[idx - 1], X[idx], t), Y[idx - 1], Y[idx]);
+				}
+			}
+		}
 	};
 
 	class QuatSquadSpline : public InterpolationSystem<RE::NiQuaternion>
@@ -467,6 +701,13 @@ public:
 			float normalizedT = NormalizeTime(curSeg.startTime, curSeg.endTime, t);
 			return QuatSquad(curSeg.q0, curSeg.t0, curSeg.t1, curSeg.q1, normalizedT);
 		}
+
+		virtual void Evaluate(std::span<const float> times, std::span<RE::NiQuaternion> out)
+		{
+			EvaluateSegments(segs, times, out, [](const Segment& seg, float normalizedT) {
+				return QuatSquad(seg.q0, seg.t0, seg.t1, seg.q1, normalizedT);
+			});
+		}
 	};
 
 	class QuatCatmullRomSpline : public InterpolationSystem<RE::NiQuaternion>
@@ -543,6 +784,15 @@ public:
 			dh::quat_hermite(reinterpret_cast<dh::quat&>(result), normalizedT, curSeg.q1, curSeg.q2, curSeg.v1, curSeg.v2);
 			return result;
 		}
+
+		virtual void Evaluate(std::span<const float> times, std::span<RE::NiQuaternion> out)
+		{
+			EvaluateSegments(segs, times, out, [](const Segment& seg, float normalizedT) {
+				RE::NiQuaternion result;
+				dh::quat_hermite(reinterpret_cast<dh::quat&>(result), normalizedT, seg.q1, seg.q2, seg.v1, seg.v2);
+				return result;
+			});
+		}
 	};
 
 	class QuatNaturalCubicSpline : public InterpolationSystem<RE::NiQuaternion>
@@ -572,6 +822,23 @@ public:
 			if (!impl)
 				return {};
 
+			return Sample(t);
+		}
+
+		virtual void Evaluate(std::span<const float> times, std::span<RE::NiQuaternion> out)
+		{
+			if (!impl)
+				return InterpolationSystem::Evaluate(times, out);
+
+			const size_t count = std::min(times.size(), out.size());
+			for (size_t i = 0; i < count; i++) {
+				out[i] = Sample(times[i]);
+			}
+		}
+
+	private:
+		RE::NiQuaternion Sample(float t)
+		{
 			auto res = (*impl)(t);
 			RE::NiQuaternion resQ{
 				res.R_component_1(),
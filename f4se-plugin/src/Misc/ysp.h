@@ -340,7 +340,7 @@ namespace ysp
 		/** Q^x (Q: quat, x: real) for spatial rotation quaternion */
 		inline quaternion spatial_power(T v) const
 		{
-			auto theta = std::acosf(_r) * v;
+			auto theta = std::acos(_r) * v;
 			auto sq = std::sqrt(_i * _i + _j * _j + _k * _k);
 			if (sq != static_cast<T>(0))
 				sq = static_cast<T>(1) / sq;
@@ -10,6 +10,8 @@ namespace PackageOverride
 		SerializableForm<RE::TESPackage> package = nullptr;
 		bool reserved = false;
 		std::optional<std::unique_ptr<PackageEndFunctor>> doneCallback = std::nullopt;
+		//Key of this entry in callbackIndex, or 0 if it isn't indexed. Not serialized.
+		uint64_t callbackKey = 0;
 
 		template <class Archive>
 		void serialize(Archive& ar, const uint32_t)
@@ -18,6 +20,92 @@ namespace PackageOverride
 		}
 	};
 
+	//Lets lookups turn away keys that aren't in the package state without taking the lock.
+	//Counts how many keys hash to each slot, so a zero slot means the key is definitely absent.
+	//Only modified while holding the exclusive lock.
+	class HandleFilter
+	{
+	public:
+		bool MayContain(uint32_t a_key) const
+		{
+			return total.load(std::memory_order_acquire) > 0 && slots[Slot(a_key)].load(std::memory_order_acquire) > 0;
+		}
+
+		void Add(uint32_t a_key)
+		{
+			slots[Slot(a_key)].fetch_add(1, std::memory_order_release);
+			total.fetch_add(1, std::memory_order_release);
+		}
+
+		void Remove(uint32_t a_key)
+		{
+			total.fetch_sub(1, std::memory_order_release);
+			slots[Slot(a_key)].fetch_sub(1, std::memory_order_release);
+		}
+
+		void Clear()
+		{
+			total.store(0, std::memory_order_release);
+			for (auto& s : slots) {
+				s.store(0, std::memory_order_release);
+			}
+		}
+
+		template <typename Map>
+		void Rebuild(const Map& a_packages)
+		{
+			Clear();
+			for (auto& p : a_packages) {
+				Add(p.first.hash());
+			}
+		}
+
+	private:
+		static constexpr uint32_t SlotBits = 10;
+
+		static size_t Slot(uint32_t a_key)
+		{
+			return (a_key * 2654435761u) >> (32 - SlotBits);
+		}
+
+		std::atomic<uint32_t> total = 0;
+		std::array<std::atomic<uint32_t>, (1u << SlotBits)> slots{};
+	};
+
+	//Actor handles with an override.
+	HandleFilter filter;
+	//Actor form IDs with a pending done callback.
+	HandleFilter callbackFilter;
+	//(actor form ID, package form ID) -> entry with a pending done callback, for package end events.
+	std::unordered_map<uint64_t, SerializableActorHandle> callbackIndex;
+
+	inline uint64_t GetCallbackKey(uint32_t a_actorFormId, uint32_t a_pkgFormId)
+	{
+		return (static_cast<uint64_t>(a_actorFormId) << 32) | a_pkgFormId;
+	}
+
+	void IndexCallback(const SerializableActorHandle& a_hndl, PackageInfo& a_info)
+	{
+		auto pkg = a_info.package.get();
+		auto a = a_hndl.get();
+		if (!a_info.doneCallback.has_value() || pkg == nullptr || !a)
+			return;
+
+		a_info.callbackKey = GetCallbackKey(a->formID, pkg->formID);
+		callbackIndex[a_info.callbackKey] = a_hndl;
+		callbackFilter.Add(a->formID);
+	}
+
+	void UnindexCallback(PackageInfo& a_info)
+	{
+		if (a_info.callbackKey == 0)
+			return;
+
+		callbackIndex.erase(a_info.callbackKey);
+		callbackFilter.Remove(static_cast<uint32_t>(a_info.callbackKey >> 32));
+		a_info.callbackKey = 0;
+	}
+
 	struct PersistentState
 	{
 		std::unordered_map<SerializableActorHandle, PackageInfo> packages;
@@ -32,13 +120,6 @@ namespace PackageOverride
 		void load(Archive& ar, const uint32_t)
 		{
 			ar(packages);
-			for (auto iter = packages.begin(); iter != packages.end();) {
-				if (iter->second.package != nullptr && SetPackage(iter->first, iter->second.package)) {
-					iter++;
-				} else {
-					iter = packages.erase(iter);
-				}
-			}
 		}
 
 		static bool SetPackage(RE::ActorHandle hndl, RE::TESPackage* pkg) {
@@ -65,18 +146,17 @@ namespace PackageOverride
 		public Data::EventListener<PkgEventListener>
 	{
 		virtual RE::BSEventNotifyControl ProcessEvent(const RE::TESPackageEvent& a_event, RE::BSTEventSource<RE::TESPackageEvent>*) override {
-			if (a_event.type == RE::TESPackageEvent::End && a_event.refr != nullptr) {
+			if (a_event.type == RE::TESPackageEvent::End && a_event.refr != nullptr && callbackFilter.MayContain(a_event.refr->formID)) {
 				std::unique_ptr<PackageEndFunctor> queuedCallback = nullptr;
 				{
-					std::shared_lock l{ lock };
-
-					for (auto& info : state->packages) {
-						if (auto a = info.first.get().get(); a && a->formID == a_event.refr->formID
-							&& info.second.package.get() != nullptr && info.second.package.get()->formID == a_event.formId
-							&& info.second.doneCallback.has_value()) {
-							queuedCallback = std::move(info.second.doneCallback.value());
-							queuedCallback->data = info.first;
-							info.second.doneCallback = std::nullopt;
+					std::unique_lock l{ lock };
+
+					if (auto idx = callbackIndex.find(GetCallbackKey(a_event.refr->formID, a_event.formId)); idx != callbackIndex.end()) {
+						if (auto info = state->packages.find(idx->second); info != state->packages.end() && info->second.doneCallback.has_value()) {
+							queuedCallback = std::move(info->second.doneCallback.value());
+							queuedCallback->data = info->first;
+							info->second.doneCallback = std::nullopt;
+							UnindexCallback(info->second);
 						}
 					}
 				}
@@ -87,13 +167,13 @@ namespace PackageOverride
 			return RE::BSEventNotifyControl::kContinue;
 		}
 
-		void OnGameDataReady(Data::Events::event_type, Data::Events::EventData&) {
+		void OnGameDataReady(Data::Events::event_type, const Data::Events::NoData&) {
 			RE::TESObjectREFR_Events::RegisterForPackage(this);
 		}
 	protected:
 		friend class Singleton;
 		PkgEventListener() {
-			RegisterListener(Data::Events::GAME_DATA_READY, &PkgEventListener::OnGameDataReady);
+			RegisterListener<Data::Events::GAME_DATA_READY>(&PkgEventListener::OnGameDataReady);
 		}
 	};
 
@@ -103,23 +183,41 @@ namespace PackageOverride
 			return true;
 		}
 
+		auto hndl = a_actor->GetActorHandle();
+		if (!filter.MayContain(hndl.native_handle_const())) {
+			return true;
+		}
+
 		std::shared_lock l{ lock };
-		return !state->packages.contains(a_actor->GetActorHandle());
+		return !state->packages.contains(hndl);
 	}
 
 	bool Set(RE::ActorHandle a_hndl, RE::TESPackage* a_pkg, bool reserved = false, std::optional<std::unique_ptr<PackageEndFunctor>> doneCallback = std::nullopt)
 	{
 		std::unique_lock l{ lock };
 
-		if (auto itm = state->packages.find(a_hndl); !reserved && itm != state->packages.end() && itm->second.reserved) {
+		auto itm = state->packages.find(a_hndl);
+		if (!reserved && itm != state->packages.end() && itm->second.reserved) {
 			return false;
 		}
 
+		//Added before the package is applied, so evaluations triggered in the meantime fall through to the locked check.
+		const bool isNew = itm == state->packages.end();
+		if (isNew) {
+			filter.Add(a_hndl.native_handle_const());
+		}
+
 		if (!PersistentState::SetPackage(a_hndl, a_pkg)) {
+			if (isNew) {
+				filter.Remove(a_hndl.native_handle_const());
+			}
 			return false;
 		}
 
-		state->packages[a_hndl] = { a_pkg, reserved, std::move(doneCallback) };
+		auto& info = state->packages[a_hndl];
+		UnindexCallback(info);
+		info = { a_pkg, reserved, std::move(doneCallback) };
+		IndexCallback(a_hndl, info);
 		return true;
 	}
 
@@ -128,13 +226,58 @@ namespace PackageOverride
 		std::unique_lock l{ lock };
 		auto itm = state->packages.find(a_hndl);
 		if (itm != state->packages.end() && (reserved || !itm->second.reserved)) {
+			const uint32_t hndl = itm->first.hash();
+			UnindexCallback(itm->second);
 			state->packages.erase(itm);
+			filter.Remove(hndl);
+		}
+	}
+
+	//Re-applies loaded package overrides to their actors once the loaded state has been swapped in.
+	//The filter is rebuilt first, so evaluations triggered while the packages are applied already see the overrides.
+	//Packages are applied without holding the lock, as evaluating them runs through IsEvalAllowed.
+	void OnLoad() {
+		std::vector<std::pair<SerializableActorHandle, RE::TESPackage*>> pending;
+		{
+			std::unique_lock l{ lock };
+			filter.Rebuild(state->packages);
+			callbackIndex.clear();
+			callbackFilter.Clear();
+			pending.reserve(state->packages.size());
+			for (auto& p : state->packages) {
+				IndexCallback(p.first, p.second);
+				pending.emplace_back(p.first, p.second.package.get());
+			}
+		}
+
+		std::vector<std::pair<SerializableActorHandle, RE::TESPackage*>> failed;
+		for (auto& p : pending) {
+			if (!PersistentState::SetPackage(p.first, p.second)) {
+				failed.push_back(p);
+			}
+		}
+
+		if (failed.empty())
+			return;
+
+		std::unique_lock l{ lock };
+		for (auto& f : failed) {
+			//Skip entries that were replaced while the packages were being applied.
+			if (auto itm = state->packages.find(f.first); itm != state->packages.end() && itm->second.package.get() == f.second) {
+				const uint32_t hndl = itm->first.hash();
+				UnindexCallback(itm->second);
+				state->packages.erase(itm);
+				filter.Remove(hndl);
+			}
 		}
 	}
 
 	void Reset() {
 		std::unique_lock l{ lock };
 		state->packages.clear();
+		filter.Clear();
+		callbackIndex.clear();
+		callbackFilter.Clear();
 	}
 }
 
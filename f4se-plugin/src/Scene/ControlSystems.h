@@ -310,7 +310,7 @@ namespace Scene
 			evntData.newPosition = sys->QSystemID();
 			evntData.successful = true;
 			evntData.treeId = id;
-			Data::Events::Send(Data::Events::TREE_POS_CHANGE, evntData);
+			Data::Events::Send<Data::Events::TREE_POS_CHANGE>(evntData);
 
 			QueueSubSystem(std::move(sys));
 			return true;
@@ -345,10 +345,10 @@ namespace Scene
 			if (autoAdvance) {
 				Advance(true);
 			} else if (hudActive) {
-				RegisterListener(Data::Events::HUD_DOWN_KEY_DOWN, &PositionTreeControlSystem::OnHudKey);
-				RegisterListener(Data::Events::HUD_UP_KEY_DOWN, &PositionTreeControlSystem::OnHudKey);
-				RegisterListener(Data::Events::HUD_LEFT_KEY_DOWN, &PositionTreeControlSystem::OnHudKey);
-				RegisterListener(Data::Events::HUD_RIGHT_KEY_DOWN, &PositionTreeControlSystem::OnHudKey);
+				RegisterListener<Data::Events::HUD_DOWN_KEY_DOWN>(&PositionTreeControlSystem::OnHudKey);
+				RegisterListener<Data::Events::HUD_UP_KEY_DOWN>(&PositionTreeControlSystem::OnHudKey);
+				RegisterListener<Data::Events::HUD_LEFT_KEY_DOWN>(&PositionTreeControlSystem::OnHudKey);
+				RegisterListener<Data::Events::HUD_RIGHT_KEY_DOWN>(&PositionTreeControlSystem::OnHudKey);
 				UpdateHUDState();
 			}	
 		}
@@ -440,7 +440,7 @@ namespace Scene
 			UpdateHUDState(timerDur);
 		}
 
-		void OnHudKey(Data::Events::event_type e, Data::Events::EventData&)
+		void OnHudKey(Data::Events::event_type e, const Data::Events::NoData&)
 		{
 			SceneManager::VisitScene(parentId, [&](IScene* scn) {
 				scn->controlSystem->Notify(e);
@@ -542,7 +542,9 @@ namespace Scene
 			}
 		}
 
-		virtual ~PositionTreeControlSystem() {}
+		virtual ~PositionTreeControlSystem() {
+			UnregisterAllListeners();
+		}
 
 		template <class Archive>
 		void serialize(Archive& ar, const uint32_t ver)
@@ -47,7 +47,7 @@ namespace Scene
 			return RE::BSEventNotifyControl::kContinue;
 		}
 
-		void OnGameDataReady(Data::Events::event_type, Data::Events::EventData&) {
+		void OnGameDataReady(Data::Events::event_type, const Data::Events::NoData&) {
 			RE::TESObjectREFR_Events::RegisterForHit(this);
 			RE::TESObjectREFR_Events::RegisterForDeath(this);
 			RE::TESObjectREFR_Events::RegisterForActorLocationChange(this);
@@ -55,7 +55,7 @@ namespace Scene
 	protected:
 		friend class Singleton;
 		EventProxy() {
-			RegisterListener(Data::Events::GAME_DATA_READY, &EventProxy::OnGameDataReady);
+			RegisterListener<Data::Events::GAME_DATA_READY>(&EventProxy::OnGameDataReady);
 		}
 	};
 }
@@ -231,10 +231,52 @@ namespace Scene
 		std::string stopEquipSet;
 		SceneSettings settings;
 
+		//Runtime scheduling state, managed by SceneManager::UpdateScenes. Not serialized.
+		struct Schedule
+		{
+			struct SettledActor
+			{
+				RE::NiPointer<RE::Actor> actor;
+				RE::NiPoint3 location;
+				RE::NiPoint3 angle;
+			};
+
+			std::atomic<double> nextUpdateMs = 0.0;
+			bool sleeping = false;
+			double updateMs = 0.0;
+			uint32_t updates = 0;
+			//Where each actor was when the scene went to sleep. Only touched by UpdateScenes, which compares them
+			//every frame without locking the scene, so an actor that's moved out of place wakes it right away.
+			std::vector<SettledActor> settledActors;
+		};
+		Schedule schedule;
+
 		IScene()
 		{
 		}
 
+		//Makes the scene update again on the next frame. Must be called with the scene locked whenever
+		//something changes that a sleeping scene has to react to.
+		void Wake()
+		{
+			schedule.nextUpdateMs = 0.0;
+			schedule.sleeping = false;
+		}
+
+		//How long the scene can go without updates after the current one, in milliseconds.
+		//0 means it has to keep updating at the regular rate.
+		virtual double QSettledDuration() { return 0.0; }
+
+		//Current time of the tracked animation, read from the lead actor's graph on request.
+		virtual float QAnimTime() { return animTime; }
+
+		//Called when the generator of the lead actor's graph reports a loop. Reports from listeners
+		//that have since been replaced carry an outdated token and are ignored.
+		virtual void OnAnimationLoopEvent(uint32_t) {}
+
+		//Called when the lead actor's Havok graph is predicted to have looped.
+		virtual void CheckAnimationLoop() {}
+
 		virtual bool PushQueuedControlSystem() { return false; }
 
 		virtual void OnActorDeath(RE::Actor*) {}
@@ -286,13 +328,23 @@ namespace Scene
 
 		virtual void SetSyncState(SyncState) {}
 
-		void ForEachActor(std::function<void(RE::Actor*, ActorPropertyMap&)> func, bool require3d = true)
+		template <typename F>
+		void ForEachActor(F&& func, bool require3d = true)
+		{
+			ForEachActorIndexed([&](RE::Actor* a, size_t i) {
+				func(a, actors.GetProperties(i));
+			}, require3d);
+		}
+
+		//Same as ForEachActor, but passes the actor's row in the actors table instead of its property map.
+		template <typename F>
+		void ForEachActorIndexed(F&& func, bool require3d = true)
 		{
 			RE::NiPointer<RE::Actor> currentActor = nullptr;
-			for (auto& a : actors) {
-				currentActor = a.first.get();
+			for (size_t i = 0; i < actors.size(); i++) {
+				currentActor = actors.GetHandle(i).get();
 				if (GameUtil::ActorIsEnabled(currentActor.get(), require3d)) {
-					func(currentActor.get(), a.second);
+					func(currentActor.get(), i);
 				}
 			}
 		}
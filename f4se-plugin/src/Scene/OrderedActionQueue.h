@@ -30,36 +30,104 @@ namespace Scene
 			}
 		};
 
+		struct QueuedAction
+		{
+			enum Type : uint8_t
+			{
+				kCustom,
+				kDelay,
+				kUnEquip,
+				kReEquip,
+				kAddEquipment,
+				kRemoveEquipment,
+				kApplyMorphs
+			};
+
+			Type type = kCustom;
+			RE::NiPointer<RE::Actor> actor = nullptr;
+			std::optional<uint8_t> slot = std::nullopt;
+			RE::TESBoundObject* form = nullptr;
+			uint8_t frames = 0;
+			Data::Morphs morphs;
+			std::function<bool()> func = nullptr;
+			bool cancelled = false;
+		};
+
+		//Instrumentation for a burst of queued actions, logged once the queue has drained.
+		struct BurstStats
+		{
+			size_t peakDepth = 0;
+			uint32_t actionsRun = 0;
+			uint32_t actionsCoalesced = 0;
+			uint32_t frames = 0;
+			double longestFrameMs = 0.0;
+		};
+
 		inline static std::unique_ptr<PersistentState> state = std::make_unique<PersistentState>();
-		inline static std::queue<std::function<bool()>> equipQueue;
+		inline static std::deque<QueuedAction> equipQueue;
 		inline static uint16_t delayCounter = 0;
+		inline static BurstStats stats;
+		//Actors whose morphs were changed this frame, updated once at the end of the frame.
+		inline static std::vector<RE::NiPointer<RE::Actor>> dirtyMorphs;
 		inline static safe_mutex lock;
 
+		//Runs queued actions until the queue empties, a delay is reached or the frame's time budget is used up.
+		//At least one action runs per frame, so the queue always makes progress.
 		static void Update() {
 			std::unique_lock l{ lock };
 			if (delayCounter > 0) {
 				delayCounter--;
 				return;
 			}
+			if (equipQueue.empty())
+				return;
+
+			auto timer = Utility::CreatePerfCounter();
+			double budgetMs = Data::Settings::Values.iActionQueueBudgetUs / 1000.0;
+			bool ranAny = false;
+
 			while (!equipQueue.empty()) {
-				auto& func = equipQueue.front();
-				func();
-				equipQueue.pop();
+				if (ranAny && budgetMs > 0.0 && Utility::QueryPerfCounterTime(timer) >= budgetMs) {
+					break;
+				}
+
+				QueuedAction action = std::move(equipQueue.front());
+				equipQueue.pop_front();
+				if (action.cancelled)
+					continue;
+
+				Process(action);
+				ranAny = true;
+				stats.actionsRun++;
 
 				if (delayCounter > 0) {
 					break;
 				}
 			}
+
+			for (auto& a : dirtyMorphs) {
+				LooksMenu::UpdateMorphs(a.get());
+			}
+			dirtyMorphs.clear();
+
+			stats.frames++;
+			stats.longestFrameMs = std::max(stats.longestFrameMs, Utility::QueryPerfCounterTime(timer));
+
+			if (equipQueue.empty()) {
+				logger::debug("Action queue drained: {} actions ran over {} frames, {} coalesced, peak depth {}, longest frame {:.3f}ms.",
+					stats.actionsRun, stats.frames, stats.actionsCoalesced, stats.peakDepth, stats.longestFrameMs);
+				stats = BurstStats{};
+			}
 		}
 
 		static void InsertCustom(const std::function<bool()>& func) {
 			std::unique_lock l{ lock };
-			equipQueue.push(func);
+			Push({ .type = QueuedAction::kCustom, .func = func });
 		}
 
 		static void InsertDelay(uint8_t frames) {
 			std::unique_lock l{ lock };
-			equipQueue.push([frames = frames]() { delayCounter += frames; return true; });
+			Push({ .type = QueuedAction::kDelay, .frames = frames });
 		}
 
 		static void UnEquip(RE::Actor* a, uint8_t slot) {
@@ -67,22 +135,47 @@ namespace Scene
 			if (!a || !a->biped)
 				return;
 
-			equipQueue.push(std::function<bool()>(std::bind(&ProcessUnEquip, RE::NiPointer<RE::Actor>(a), slot)));
+			Push({ .type = QueuedAction::kUnEquip, .actor = RE::NiPointer<RE::Actor>(a), .slot = slot });
 		}
 
+		//A re-equip that would only undo a still-pending unequip of the same slot cancels it instead, as long as nothing
+		//is stored for that slot yet and no other action for the actor is queued in between, in which case the pair would
+		//have no net effect. Anything in between, such as added equipment, may rely on the unequip having stored the slot.
 		static void ReEquip(RE::Actor* a, std::optional<uint8_t> slot = std::nullopt) {
 			std::unique_lock l{ lock };
 			if (!a || !a->biped)
 				return;
 
-			equipQueue.push(std::function<bool()>(std::bind(&ProcessReEquip, RE::NiPointer<RE::Actor>(a), slot)));
+			auto storedIter = state->equipment.find(a->GetActorHandle());
+			bool hasStored = storedIter != state->equipment.end() && !storedIter->second.storedEquipment.empty();
+			if (!hasStored || (slot.has_value() && !storedIter->second.storedEquipment.contains(slot.value()))) {
+				bool cancelledAny = false;
+				ForEachPending(a, [&](QueuedAction& p) {
+					if (p.type != QueuedAction::kUnEquip || (slot.has_value() && p.slot != slot))
+						return false;
+
+					p.cancelled = true;
+					cancelledAny = true;
+					stats.actionsCoalesced++;
+					return true;
+				});
+
+				if (cancelledAny) {
+					stats.actionsCoalesced++;
+					return;
+				}
+			}
+
+			Push({ .type = QueuedAction::kReEquip, .actor = RE::NiPointer<RE::Actor>(a), .slot = slot });
 		}
 
 		static void Reset() {
 			std::unique_lock l{ lock };
 			state->equipment.clear();
-			equipQueue = std::queue<std::function<bool()>>();
+			equipQueue.clear();
+			dirtyMorphs.clear();
 			delayCounter = 0;
+			stats = BurstStats{};
 		}
 
 		static void AddEquipment(RE::Actor* a, RE::TESBoundObject* equipForm) {
@@ -90,7 +183,7 @@ namespace Scene
 			if (!a || !a->biped || !equipForm)
 				return;
 
-			equipQueue.push(std::function<bool()>(std::bind(&ProcessAddEquipment, RE::NiPointer<RE::Actor>(a), equipForm)));
+			Push({ .type = QueuedAction::kAddEquipment, .actor = RE::NiPointer<RE::Actor>(a), .form = equipForm });
 		}
 
 		static void RemoveEquipment(RE::Actor* a, RE::TESBoundObject* equipForm)
@@ -99,18 +192,75 @@ namespace Scene
 			if (!a || !a->biped || !equipForm)
 				return;
 
-			equipQueue.push(std::function<bool()>(std::bind(&ProcessRemoveEquipment, RE::NiPointer<RE::Actor>(a), equipForm)));
+			Push({ .type = QueuedAction::kRemoveEquipment, .actor = RE::NiPointer<RE::Actor>(a), .form = equipForm });
 		}
 
+		//Morphs queued for an actor that already has morphs pending are merged into one application at the
+		//position of the latest request, so LooksMenu only has to update the actor's morphs once.
 		static void ApplyMorphs(RE::Actor* a, const Data::Morphs& m) {
 			std::unique_lock l{ lock };
 			if (!a)
 				return;
 
-			equipQueue.push(std::function<bool()>(std::bind(&ProcessApplyMorphs, RE::NiPointer<RE::Actor>(a), m)));
+			Data::Morphs merged;
+			ForEachPending(a, [&](QueuedAction& p) {
+				if (p.type == QueuedAction::kApplyMorphs) {
+					merged.insert(merged.end(), p.morphs.begin(), p.morphs.end());
+					p.cancelled = true;
+					stats.actionsCoalesced++;
+				}
+				return true;
+			});
+			merged.insert(merged.end(), m.begin(), m.end());
+
+			Push({ .type = QueuedAction::kApplyMorphs, .actor = RE::NiPointer<RE::Actor>(a), .morphs = std::move(merged) });
 		}
 
 		private:
+		static void Push(QueuedAction&& action) {
+			equipQueue.push_back(std::move(action));
+			stats.peakDepth = std::max(stats.peakDepth, equipQueue.size());
+		}
+
+		//Visits the actor's pending actions back to front until visitFunc returns false. Stops at the last custom action or delay,
+		//since custom actions can depend on anything queued before them, and delays separate actions that were meant to run apart.
+		static void ForEachPending(RE::Actor* a, const std::function<bool(QueuedAction&)>& visitFunc) {
+			for (auto iter = equipQueue.rbegin(); iter != equipQueue.rend(); iter++) {
+				if (iter->type == QueuedAction::kCustom || iter->type == QueuedAction::kDelay)
+					break;
+
+				if (!iter->cancelled && iter->actor.get() == a && !visitFunc(*iter)) {
+					break;
+				}
+			}
+		}
+
+		static void Process(QueuedAction& action) {
+			switch (action.type) {
+			case QueuedAction::kCustom:
+				action.func();
+				break;
+			case QueuedAction::kDelay:
+				delayCounter += action.frames;
+				break;
+			case QueuedAction::kUnEquip:
+				ProcessUnEquip(action.actor, action.slot.value());
+				break;
+			case QueuedAction::kReEquip:
+				ProcessReEquip(action.actor, action.slot);
+				break;
+			case QueuedAction::kAddEquipment:
+				ProcessAddEquipment(action.actor, action.form);
+				break;
+			case QueuedAction::kRemoveEquipment:
+				ProcessRemoveEquipment(action.actor, action.form);
+				break;
+			case QueuedAction::kApplyMorphs:
+				ProcessApplyMorphs(action.actor, std::move(action.morphs));
+				break;
+			}
+		}
+
 		static bool ProcessUnEquip(RE::NiPointer<RE::Actor> a, uint8_t slot)
 		{
 			auto targetItem = a->biped->object[slot].parent;
@@ -208,7 +358,9 @@ namespace Scene
 
 		static bool ProcessApplyMorphs(RE::NiPointer<RE::Actor> a, Data::Morphs m)
 		{
-			m.ProcessApply(a.get());
+			if (m.SetChanged(a.get()) && std::find_if(dirtyMorphs.begin(), dirtyMorphs.end(), [&](const auto& d) { return d.get() == a.get(); }) == dirtyMorphs.end()) {
+				dirtyMorphs.push_back(a);
+			}
 			return true;
 		}
 
@@ -50,9 +50,9 @@ namespace Scene
 	{
 		if (!Data::Settings::Values.bDisableRescaler) {
 			SceneManager::VisitScene(sceneId, [](IScene* scn) {
-				scn->ForEachActor([&](RE::Actor* currentActor, ActorPropertyMap& props) {
+				scn->ForEachActorIndexed([&](RE::Actor* currentActor, size_t i) {
 					float targetScale = 1.0f;
-					if (auto customScale = GetProperty<float>(props, kScale); customScale.has_value()) {
+					if (const auto& customScale = scn->actors.GetScale(i); customScale.has_value()) {
 						targetScale = customScale.value();
 					} else if (auto npc = currentActor->GetNPC(); currentActor != player && npc != nullptr) {
 						targetScale = player->GetScale();
@@ -114,14 +114,23 @@ namespace Scene
 					GameUtil::SetFlyCam(false);
 				}
 				scn->detachQueued = true;
+				scn->Wake();
 			},
 			true);
 	}
+
+	void ProcessLoopCheckFunctor(uint64_t sceneId)
+	{
+		SceneManager::VisitScene(sceneId, [](IScene* scn) {
+			scn->CheckAnimationLoop();
+		});
+	}
 }
 
 SCNSYNC_DELAY_FUNCTOR(PostStart);
 SCNSYNC_DELAY_FUNCTOR(Stop);
 SCNSYNC_DELAY_FUNCTOR(PostStop);
+SCNSYNC_DELAY_FUNCTOR(LoopCheck);
 
 namespace Scene
 {
@@ -139,6 +148,11 @@ namespace Scene
 	// further tweaking, so I'm leaving it here for future configuration.
 	inline static const float playerSyncOffset = 0.010f;
 
+	// Havok loop checks are scheduled this long after the predicted loop, so that they land after it
+	// despite frame timing. Checks that can't read the graph time retry after loopRetryMs.
+	inline static const double loopCheckMarginMs = 20.0;
+	inline static const double loopRetryMs = 250.0;
+
 	static std::unique_ptr<IControlSystem> GetControlSystem(std::shared_ptr<const Data::Position> position, bool excludeTrees)
 	{
 		std::unique_ptr<IControlSystem> sys = nullptr;
@@ -178,6 +192,11 @@ namespace Scene
 		float basicallyFullSpeed = 100.0f * 0.9999f;
 		RE::NiPoint3 baseLocation;
 		RE::NiPoint3 baseAngle;
+		//Whether the last update had to move any actors back into place. Not serialized.
+		bool actorsCorrected = false;
+		//Whether loops of the tracked animation are currently being listened for, re-armed by the next update when reset. Not serialized.
+		bool loopArmed = false;
+		uint32_t loopToken = 0;
 
 		virtual ~Scene()
 		{
@@ -302,7 +321,7 @@ namespace Scene
 			});
 
 			status = SceneState::Active;
-			Data::Events::Send(Data::Events::SCENE_START, uid);
+			Data::Events::Send<Data::Events::SCENE_START>(uid);
 			tasks.Start<DelegateFunctor<PostStartDelegate>>(50, uid);
 			return true;
 		}
@@ -323,6 +342,7 @@ namespace Scene
 			}
 
 			tasks.StopAll();
+			DisarmLoopTracking();
 			SetAnimMult(100);
 
 			ForEachActor([&](RE::Actor* currentActor, ActorPropertyMap& props) {
@@ -358,7 +378,7 @@ namespace Scene
 			}, false);
 
 			status = SceneState::PendingDeletion;
-			Data::Events::Send(Data::Events::SCENE_END, Data::Events::SceneData{ uid, GetActorsInOrder(actors) });
+			Data::Events::Send<Data::Events::SCENE_END>(Data::Events::SceneData{ uid, GetActorsInOrder(actors) });
 			tasks.Start<DelegateFunctor<PostStopDelegate>>(50, uid);
 			return true;
 		}
@@ -439,8 +459,8 @@ namespace Scene
 
 		void ClearAnimObjects() {
 			const auto t_intfc = F4SE::GetTaskInterface();
-			for(auto& p : actors) {
-				t_intfc->AddTask([hndl = p.first]() {
+			for(auto& h : actors.GetHandles()) {
+				t_intfc->AddTask([hndl = h]() {
 					if (auto a = hndl.get(); a != nullptr) {
 						RE::BSAnimationGraphEvent evnt{ a.get(), "AnimObjUnequip", "" };
 						RE::BGSAnimationSystemUtils::NotifyGraphSources(a.get(), evnt);
@@ -483,7 +503,7 @@ namespace Scene
 
 			ClearAnimObjects();
 			PlayAnimations();
-			Data::Events::Send(Data::Events::SCENE_ANIM_CHANGE, std::pair<uint64_t, std::string>{ uid, anim->id });
+			Data::Events::Send<Data::Events::SCENE_ANIM_CHANGE>({ uid, anim->id });
 		}
 
 		virtual void PlayAnimations() override {
@@ -525,7 +545,7 @@ namespace Scene
 
 			QueueControlSystem(GetControlSystem(targetPos));
 
-			Data::Events::Send(Data::Events::SCENE_POS_CHANGE, Data::Events::ScenePositionData{ uid, id, true });
+			Data::Events::Send<Data::Events::SCENE_POS_CHANGE>(Data::Events::ScenePositionData{ uid, id, true });
 			return true;
 		}
 
@@ -543,33 +563,131 @@ namespace Scene
 			angle.z = baseAngle.z + a_angle.z;
 
 			MathUtil::ConstrainRadians(angle);
+			Wake();
 		}
 
 		virtual void SetAnimMult(float mult) override {
+			Wake();
+			loopArmed = false;
 			animMult = mult;
 			diffLimit = animMult * 0.05f;
 			basicallyFullSpeed = animMult * 0.9999f;
 			ForEachActor([&](RE::Actor* currentActor, ActorPropertyMap&) {
 				GameUtil::SetAnimMult(currentActor, mult);
 			});
-			Data::Events::Send(Data::Events::SCENE_SPEED_CHANGE, std::pair<uint64_t, float>{ uid, mult });
+			Data::Events::Send<Data::Events::SCENE_SPEED_CHANGE>({ uid, mult });
 		}
 
 		virtual void SetSyncState(SyncState s) override {
 			if (syncStatus != s) {
+				Wake();
 				syncStatus = s;
-				Data::Events::Send(Data::Events::SCENE_SYNC_STATUS_CHANGE, std::pair<uint64_t, SyncState>{ uid, s });
+				Data::Events::Post<Data::Events::SCENE_SYNC_STATUS_CHANGE>({ uid, s });
 			}
 		}
 
 		void SetTrackAnimTime(bool track) {
 			if (track != trackAnimTime) {
+				Wake();
 				trackAnimTime = track;
 				animTime = 0.0f;
 				lastAnimTime = 0.0f;
+				DisarmLoopTracking();
 			}
 		}
 
+		void DisarmLoopTracking() {
+			ResetLoopTracking();
+			if (auto trackingActor = actors.GetHandle(0).get(); trackingActor != nullptr) {
+				BodyAnimation::SmartIdle::SetLoopListener(trackingActor.get(), nullptr);
+			}
+		}
+
+		void ArmLoopTracking() {
+			ResetLoopTracking();
+			TrackAnimationLoops(false);
+		}
+
+		//Invalidates reports from the current listener & stops Havok loop checks. The listener itself is left in place.
+		void ResetLoopTracking() {
+			loopArmed = false;
+			loopToken++;
+			tasks.Stop<DelegateFunctor<LoopCheckDelegate>>();
+		}
+
+		//Loops of the lead actor's animation are reported by its generator while NAF animates it. Havok graphs
+		//can't report them, so their time is read once, then checked again right after the loop predicted from it.
+		void TrackAnimationLoops(bool checkForLoop) {
+			auto trackingActor = actors.GetHandle(0).get();
+			if (trackingActor == nullptr) {
+				loopArmed = false;
+				Wake();
+				return;
+			}
+
+			loopArmed = true;
+			bool managed = BodyAnimation::SmartIdle::SetLoopListener(trackingActor.get(), [sceneId = uid, token = loopToken]() {
+				F4SE::GetTaskInterface()->AddTask([sceneId, token]() {
+					SceneManager::VisitScene(sceneId, [token](IScene* scn) {
+						scn->OnAnimationLoopEvent(token);
+					});
+				});
+			});
+
+			if (managed)
+				return;
+
+			double delayMs = loopRetryMs;
+			if (BodyAnimation::SmartIdle::GetGraphTime(trackingActor.get(), cachedSyncInfo) &&
+				cachedSyncInfo.current >= 0.0f) {
+				animTime = cachedSyncInfo.current;
+				if (checkForLoop && animTime < lastAnimTime) {
+					OnAnimationLoop();
+					//The control system may have moved the scene on to another animation.
+					if (!loopArmed)
+						return;
+				}
+				lastAnimTime = animTime;
+
+				//A paused scene won't loop, SetAnimMult re-arms tracking once it's resumed.
+				if (animMult <= 0.0f)
+					return;
+
+				delayMs = (cachedSyncInfo.total - animTime) / (animMult / 100.0f) * 1000.0 + loopCheckMarginMs;
+			}
+
+			tasks.Start<DelegateFunctor<LoopCheckDelegate>>(std::max(delayMs, loopCheckMarginMs), uid);
+		}
+
+		void OnAnimationLoop() {
+			controlSystem->OnAnimationLoop(this);
+			Data::Events::Post<Data::Events::SCENE_ANIM_LOOP>(uid);
+		}
+
+		virtual void OnAnimationLoopEvent(uint32_t token) override {
+			if (trackAnimTime && loopArmed && token == loopToken) {
+				OnAnimationLoop();
+			}
+		}
+
+		virtual void CheckAnimationLoop() override {
+			if (trackAnimTime && loopArmed) {
+				TrackAnimationLoops(true);
+			}
+		}
+
+		virtual float QAnimTime() override {
+			if (trackAnimTime) {
+				auto trackingActor = actors.GetHandle(0).get();
+				if (trackingActor != nullptr &&
+					BodyAnimation::SmartIdle::GetGraphTime(trackingActor.get(), cachedSyncInfo) &&
+					cachedSyncInfo.current >= 0.0f) {
+					animTime = cachedSyncInfo.current;
+				}
+			}
+			return animTime;
+		}
+
 		void PerformSync() {
 			bool noActorsReady = true;
 			bool allActorsReady = true;
@@ -613,6 +731,7 @@ namespace Scene
 
 		virtual void Update() override
 		{
+			actorsCorrected = false;
 			switch (syncStatus) {
 			case Synced:
 				break;
@@ -663,42 +782,43 @@ namespace Scene
 				}
 			}
 
-			if (trackAnimTime) {
-				auto trackingActor = actors.begin()->first.get();
-				if (trackingActor != nullptr &&
-					BodyAnimation::SmartIdle::GetGraphTime(trackingActor.get(), cachedSyncInfo) &&
-					cachedSyncInfo.current >= 0.0f) {
-					animTime = cachedSyncInfo.current;
-					if (animTime < lastAnimTime) {
-						controlSystem->OnAnimationLoop(this);
-						Data::Events::Send(Data::Events::SCENE_ANIM_LOOP, uid);
-					}
-					lastAnimTime = animTime;
-				}
+			if (trackAnimTime && !loopArmed) {
+				ArmLoopTracking();
 			}
 
-			ForEachActor([&](RE::Actor* currentActor, ActorPropertyMap& props) {
+			ForEachActorIndexed([&](RE::Actor* currentActor, size_t i) {
 				if (currentActor == player) {
 					player->UpdatePlayer3D();
 				}
 				RE::NiPoint3 actorLoc = location;
 				RE::NiPoint3 actorAngle = angle;
-				if (auto offset = GetProperty<std::pair<RE::NiPoint3, float>>(props, kOffset); offset.has_value()) {
+				if (const auto& offset = actors.GetOffset(i); offset.has_value()) {
 					MathUtil::ApplyOffsetToLocalSpace(actorLoc, offset->first, actorAngle.z);
 					actorAngle.z += offset->second;
 					MathUtil::ConstrainRadian(actorAngle.z);
 				}
 				if (!MathUtil::CoordsWithinError(currentActor->data.angle, actorAngle)) {
 					currentActor->SetAngleOnReference(actorAngle);
+					actorsCorrected = true;
 				}
 				if (!MathUtil::CoordsWithinError(currentActor->data.location, actorLoc)) {
 					currentActor->SetPosition(actorLoc, true);
 					currentActor->DisableCollision();
 					currentActor->SetNoCollision(true);
+					actorsCorrected = true;
 				}
 			});
 		}
 
+		//A synced scene whose actors are all in place only has to check on them occasionally.
+		//Loops of its animation are reported to it whether it's sleeping or not, once tracking is armed.
+		virtual double QSettledDuration() override {
+			if (syncStatus != Synced || actorsCorrected || HasPlayer() || (trackAnimTime && !loopArmed))
+				return 0.0;
+
+			return static_cast<double>(Data::Settings::Values.iSettledSceneIntervalMs);
+		}
+
 		template <class Archive>
 		void serialize(Archive& ar, const uint32_t)
 		{
@@ -718,7 +838,7 @@ namespace Scene
 		auto position = settings.startPosition;
 
 		if (auto res = ValidateStartSceneArgs(settings, ignoreInScene); !res) {
-			Data::Events::Send(Data::Events::SCENE_FAILED, overrideId ? sceneIdInOut : 0ui64);
+			Data::Events::Send<Data::Events::SCENE_FAILED>(overrideId ? sceneIdInOut : 0ui64);
 			return res;
 		}
 			
@@ -730,7 +850,7 @@ namespace Scene
 		newScene->settings.ClearPreStartInfo();
 
 		for (size_t i = 0; i < actors.size(); i++) {
-			newScene->actors.insert({ actors[i]->GetActorHandle(), { { kOrder, ActorProperty{ i } } } });
+			newScene->actors.Add(actors[i]->GetActorHandle());
 		}
 
 		if (overrideId) {
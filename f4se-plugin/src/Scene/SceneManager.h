@@ -247,7 +247,7 @@ namespace Scene
 						StopWalkPackage(info.first);
 					}
 					state->actorsWalkingToScene.erase(iter);
-					Data::Events::Send(Data::Events::SCENE_END, Data::Events::SceneData{ sceneId });
+					Data::Events::Send<Data::Events::SCENE_END>(Data::Events::SceneData{ sceneId });
 					return true;
 				} else {
 					return false;
@@ -285,26 +285,79 @@ namespace Scene
 			return result;
 		}
 
+		struct SceneMetrics
+		{
+			uint64_t uid;
+			double updateMs;
+			uint32_t updates;
+			bool sleeping;
+		};
+
+		//Updates every scene that is due. Scenes that aren't synced, or that involve the player, update every frame.
+		//Synced scenes update every iActiveSceneIntervalMs, and go to sleep once they've settled, see IScene::QSettledDuration.
 		static void UpdateScenes() {
-			const auto localScenes = GetSceneMapSnapshot();
+			RefreshUpdateList();
+			const double now = Utility::QueryPerfCounterTime(schedulerEpoch);
+			const double activeInterval = static_cast<double>(Data::Settings::Values.iActiveSceneIntervalMs);
+
+			for (auto& scn : updateList) {
+				//Checked without locking the scene, so sleeping scenes cost next to nothing.
+				if (scn->schedule.nextUpdateMs.load() > now && !SettledActorsMoved(scn->schedule))
+					continue;
 
-			for (auto& scn : localScenes) {
 				std::unique_lock l{ scn->lock };
-				//If scene is queued for detach and its only references are the scene map and this function's
-				//local copy of the scene map, process the detach.
+				//If scene is queued for detach and its only references are the scene map and the update list, process the detach.
 				if (scn->detachQueued && scn.use_count() <= 2) {
 					DetachScene(scn->uid);
 					continue;
 				}
 				if (scn->status != SceneState::PendingDeletion && !scn->noUpdate && scn->actors.size() > 0) {
-					auto firstActor = scn->actors.begin()->first.get().get();
+					auto firstActor = scn->actors.GetHandle(0).get().get();
 					if (firstActor != nullptr && firstActor->parentCell != nullptr && firstActor->parentCell->loadedData != nullptr) {
+						auto timer = Utility::CreatePerfCounter();
 						scn->Update();
+
+						auto& sch = scn->schedule;
+						sch.updateMs += Utility::QueryPerfCounterTime(timer);
+						sch.updates++;
+
+						if (double settled = scn->QSettledDuration(); settled > 0.0) {
+							if (!sch.sleeping) {
+								sch.sleeping = true;
+								sch.settledActors.clear();
+								scn->ForEachActor([&](RE::Actor* a, auto&) {
+									sch.settledActors.push_back({ RE::NiPointer<RE::Actor>(a), a->data.location, a->data.angle });
+								});
+								logger::trace("Scene ID#{} sleeping, {:.3f}ms spent over {} updates.", scn->uid, sch.updateMs, sch.updates);
+							}
+							sch.nextUpdateMs = now + settled;
+						} else {
+							sch.sleeping = false;
+							sch.settledActors.clear();
+							sch.nextUpdateMs = (scn->syncStatus == SyncState::Synced && !scn->HasPlayer()) ? now + activeInterval : 0.0;
+						}
 					}
 				}
 			}
 		}
 
+		static std::optional<SceneMetrics> GetSceneMetrics(uint64_t uid) {
+			std::optional<SceneMetrics> result;
+			VisitScene(uid, [&](IScene* scn) {
+				result = { scn->uid, scn->schedule.updateMs, scn->schedule.updates, scn->schedule.sleeping };
+			});
+			return result;
+		}
+
+		static bool SettledActorsMoved(const IScene::Schedule& sch) {
+			for (const auto& s : sch.settledActors) {
+				if (!MathUtil::CoordsWithinError(s.actor->data.location, s.location) ||
+					!MathUtil::CoordsWithinError(s.actor->data.angle, s.angle))
+					return true;
+			}
+			return false;
+		}
+
 		static void Reset() {
 			const auto localScenes = GetSceneMapSnapshot();
 
@@ -315,6 +368,7 @@ namespace Scene
 
 			std::scoped_lock l{ scenesMapLock, actorsWalkingLock };
 			state = std::make_unique<PersistentState>();
+			sceneMapVersion++;
 		}
 		
 	protected:
@@ -328,6 +382,7 @@ namespace Scene
 			if (state->scenes.contains(sceneId)) {
 				result = state->scenes[sceneId];
 				state->scenes.erase(sceneId);
+				sceneMapVersion++;
 			}
 
 			return result;
@@ -336,19 +391,43 @@ namespace Scene
 		inline static void InsertSceneIntoMap(std::shared_ptr<IScene> scn) {
 			DataWriteLock l{ scenesMapLock };
 			state->scenes.insert({ scn->uid, scn });
+			sceneMapVersion++;
 		}
 
 		inline static void ClearSceneMap() {
 			DataWriteLock l{ scenesMapLock };
 			state->scenes.clear();
+			sceneMapVersion++;
+		}
+
+		//Scenes visited by UpdateScenes, rebuilt only when the scene map changes instead of being copied every frame.
+		inline static std::vector<std::shared_ptr<IScene>> updateList;
+		inline static std::atomic<uint64_t> sceneMapVersion = 0;
+		inline static uint64_t updateListVersion = UINT64_MAX;
+		inline static const PersistentState* updateListState = nullptr;
+		inline static int64_t schedulerEpoch = Utility::CreatePerfCounter();
+
+		inline static void RefreshUpdateList() {
+			DataReadLock l{ scenesMapLock };
+			//The state is also replaced wholesale when a save is loaded, which doesn't go through the map functions.
+			if (updateListVersion == sceneMapVersion && updateListState == state.get())
+				return;
+
+			updateList.clear();
+			updateList.reserve(state->scenes.size());
+			for (const auto& p : state->scenes) {
+				updateList.push_back(p.second);
+			}
+			updateListVersion = sceneMapVersion;
+			updateListState = state.get();
 		}
 
-		static void OnHudUpKey(Data::Events::event_type, Data::Events::EventData&) {
+		static void OnHudUpKey(Data::Events::event_type, const Data::Events::NoData&) {
 			if (state->playerWalkInstance > 0) {
 				CompleteWalk(state->playerWalkInstance);
 			}
 
-			Data::Events::Unsubscribe(Data::Events::HUD_UP_KEY_DOWN, keyReg);
+			Data::Events::Unsubscribe(keyReg);
 		}
 
 		static bool StartWalkPackage(RE::Actor* a, const RE::TESObjectREFR* destRefr, uint64_t uid) {
@@ -360,7 +439,7 @@ namespace Scene
 				player->DisableInputForPlayer("NAF_Scene", GetInputsToDisableForScene());
 				player->SetAIControlled(true);
 				state->playerWalkInstance = uid;
-				keyReg = Data::Events::Subscribe(Data::Events::HUD_UP_KEY_DOWN, &OnHudUpKey);
+				keyReg = Data::Events::Subscribe<Data::Events::HUD_UP_KEY_DOWN>(&OnHudUpKey);
 
 				F4SE::GetTaskInterface()->AddUITask([]() {
 					std::unique_lock l{ actorsWalkingLock };
@@ -60,7 +60,7 @@ namespace Scene
 	};
 
 	typedef std::unordered_map<PropType, ActorProperty> ActorPropertyMap;
-	typedef std::unordered_map<SerializableActorHandle, ActorPropertyMap> SceneActorsMap;
+	typedef std::pair<RE::NiPoint3, float> ActorOffset;
 
 	template <typename T>
 	std::optional<T> GetProperty(const ActorPropertyMap& m, PropType p) {
@@ -72,26 +72,119 @@ namespace Scene
 		}
 	}
 
+	//Per-scene actor table. Rows are stored in scene order, with the properties read every frame kept in
+	//their own contiguous columns, and everything else in a per-actor ActorPropertyMap.
+	class SceneActorsMap
+	{
+	public:
+		size_t size() const { return handles.size(); }
+
+		bool empty() const { return handles.empty(); }
+
+		std::optional<size_t> Find(const SerializableActorHandle& hndl) const
+		{
+			for (size_t i = 0; i < handles.size(); i++) {
+				if (handles[i] == hndl)
+					return i;
+			}
+			return std::nullopt;
+		}
+
+		bool contains(const SerializableActorHandle& hndl) const
+		{
+			return Find(hndl).has_value();
+		}
+
+		size_t Add(const SerializableActorHandle& hndl)
+		{
+			if (auto i = Find(hndl); i.has_value())
+				return i.value();
+
+			handles.push_back(hndl);
+			properties.emplace_back();
+			offsets.emplace_back();
+			scales.emplace_back();
+			return handles.size() - 1;
+		}
+
+		void clear()
+		{
+			handles.clear();
+			properties.clear();
+			offsets.clear();
+			scales.clear();
+		}
+
+		const std::vector<SerializableActorHandle>& GetHandles() const { return handles; }
+		const SerializableActorHandle& GetHandle(size_t i) const { return handles[i]; }
+		ActorPropertyMap& GetProperties(size_t i) { return properties[i]; }
+		const ActorPropertyMap& GetProperties(size_t i) const { return properties[i]; }
+		const std::optional<ActorOffset>& GetOffset(size_t i) const { return offsets[i]; }
+		const std::optional<float>& GetScale(size_t i) const { return scales[i]; }
+		void SetOffset(size_t i, const std::optional<ActorOffset>& val) { offsets[i] = val; }
+		void SetScale(size_t i, const std::optional<float>& val) { scales[i] = val; }
+
+		//Saved in the same format as the previous unordered_map<handle, ActorPropertyMap> layout.
+		template <class Archive>
+		void save(Archive& ar) const
+		{
+			std::unordered_map<SerializableActorHandle, ActorPropertyMap> m;
+			for (size_t i = 0; i < handles.size(); i++) {
+				auto& props = m[handles[i]];
+				props = properties[i];
+				props[kOrder].value = static_cast<uint64_t>(i);
+				if (offsets[i].has_value())
+					props[kOffset].value = offsets[i].value();
+				if (scales[i].has_value())
+					props[kScale].value = scales[i].value();
+			}
+			ar(m);
+		}
+
+		template <class Archive>
+		void load(Archive& ar)
+		{
+			std::unordered_map<SerializableActorHandle, ActorPropertyMap> m;
+			ar(m);
+
+			std::vector<std::pair<uint64_t, const std::pair<const SerializableActorHandle, ActorPropertyMap>*>> sorted;
+			sorted.reserve(m.size());
+			for (auto& iter : m) {
+				sorted.emplace_back(GetProperty<uint64_t>(iter.second, kOrder).value_or(UINT64_MAX), &iter);
+			}
+			std::stable_sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+			clear();
+			for (auto& s : sorted) {
+				size_t i = Add(s.second->first);
+				auto& props = properties[i];
+				props = s.second->second;
+				offsets[i] = GetProperty<ActorOffset>(props, kOffset);
+				scales[i] = GetProperty<float>(props, kScale);
+				props.erase(kOrder);
+				props.erase(kOffset);
+				props.erase(kScale);
+			}
+		}
+
+	private:
+		std::vector<SerializableActorHandle> handles;
+		std::vector<ActorPropertyMap> properties;
+		std::vector<std::optional<ActorOffset>> offsets;
+		std::vector<std::optional<float>> scales;
+	};
+
 	std::vector<RE::NiPointer<RE::Actor>> GetActorsInOrder(const SceneActorsMap& actors)
 	{
 		std::vector<RE::NiPointer<RE::Actor>> result;
-		result.resize(actors.size());
-		for (auto& iter : actors) {
-			if (auto i = GetProperty<uint64_t>(iter.second, kOrder); i.has_value() && i.value() < result.size()) {
-				result[i.value()] = iter.first.get();
-			}
+		result.reserve(actors.size());
+		for (auto& hndl : actors.GetHandles()) {
+			result.push_back(hndl.get());
 		}
 		return result;
 	}
 
 	std::vector<SerializableActorHandle> GetActorHandlesInOrder(const SceneActorsMap& actors) {
-		std::vector<SerializableActorHandle> result;
-		result.resize(actors.size());
-		for (auto& iter : actors) {
-			if (auto i = GetProperty<uint64_t>(iter.second, kOrder); i.has_value() && i.value() < result.size()) {
-				result[i.value()] = iter.first;
-			}
-		}
-		return result;
+		return actors.GetHandles();
 	}
 }
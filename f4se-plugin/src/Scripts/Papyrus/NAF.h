@@ -350,7 +350,7 @@ namespace Papyrus::NAF
 			 PackVariable(*res, static_cast<int32_t>(scn->syncStatus));
 		} },
 		{ "animationtime", [](Scene::IScene* scn, Variable* res) {
-			 PackVariable(*res, scn->animTime);
+			 PackVariable(*res, scn->QAnimTime());
 		} },
 		{ "startequipset", [](Scene::IScene* scn, Variable* res) {
 			 PackVariable(*res, scn->startEquipSet);
@@ -52,61 +52,179 @@ namespace Serialization
 			}
 		}
 
+		//Set by the save callback from Settings. Compressed records are flagged in the high bit of their size prefix,
+		//so uncompressed records keep the original [size][data] layout.
+		bool s_compressRecords = false;
+		constexpr uint32_t kCompressedRecordFlag = 0x80000000;
+
+		//Appends everything written to it to a vector, so records are encoded straight into their final storage
+		//and written from there without being copied out of a string stream.
+		class RecordOutputBuffer : public std::streambuf
+		{
+		public:
+			RecordOutputBuffer(std::vector<char>& target) :
+				data(target)
+			{
+			}
+
+		protected:
+			int_type overflow(int_type ch) override
+			{
+				if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+					data.push_back(traits_type::to_char_type(ch));
+				}
+				return traits_type::not_eof(ch);
+			}
+
+			std::streamsize xsputn(const char* s, std::streamsize n) override
+			{
+				data.insert(data.end(), s, s + n);
+				return n;
+			}
+
+		private:
+			std::vector<char>& data;
+		};
+
+		//Reused between records, so compressing a save only allocates when a record outgrows every record before it.
+		std::vector<char> s_compressBuffer;
+
+		//Reads a record's data back out of memory. The co-save interface can only read forward, and a record has to be
+		//consumed exactly up to its size whether decoding succeeds or not, so each record is read whole into one buffer
+		//first. That's a single copy, where the stream used to be built from a vector, then a string, then an istringstream.
+		class RecordInputBuffer : public std::streambuf
+		{
+		public:
+			RecordInputBuffer(const std::vector<char>& source)
+			{
+				char* begin = const_cast<char*>(source.data());
+				setg(begin, begin, begin + source.size());
+			}
+		};
+
+		//A record's data encoded into memory, written to the co-save later by WriteRecord or read from it by ReadRecord.
+		struct EncodedRecord
+		{
+			std::vector<char> data;
+			bool compressed = false;
+			bool valid = false;
+		};
+
 		template <typename T>
-		void SaveRecord(std::string_view rcrd, const T& data)
+		bool EncodeRecord(std::string_view rcrd, const T& data, EncodedRecord& out)
 		{
-			std::ostringstream buffer(std::ios::binary);
+			out.data.clear();
+			out.valid = false;
 
 			try
 			{
-				cereal::BinaryOutputArchive archive(buffer);
+				RecordOutputBuffer buffer(out.data);
+				std::ostream stream(&buffer);
+				cereal::BinaryOutputArchive archive(stream);
 				archive(data);
 			}
 			catch (std::exception& e)
 			{
 				logger::warn("Failed to serialize {} record data due to serialization error. Full Message: {}", rcrd, e.what());
-				return;
+				return false;
+			}
+
+			out.valid = true;
+			return true;
+		}
+
+		//Writes an encoded record to the currently open co-save record, compressing it first if enabled.
+		void WriteRecord(std::string_view rcrd, const EncodedRecord& record)
+		{
+			auto timer = Utility::CreatePerfCounter();
+			std::span<const char> recordData = record.data;
+			bool compress = s_compressRecords;
+
+			if (compress) {
+				s_compressBuffer.clear();
+				try
+				{
+					//The zstr stream is destroyed first, which finishes the deflate stream before the buffer is used.
+					RecordOutputBuffer buffer(s_compressBuffer);
+					std::ostream stream(&buffer);
+					zstr::ostream zStream(stream, Z_BEST_SPEED);
+					zStream.write(record.data.data(), static_cast<std::streamsize>(record.data.size()));
+				}
+				catch (std::exception& e)
+				{
+					logger::warn("Failed to compress {} record data, it will be saved uncompressed. Full Message: {}", rcrd, e.what());
+					compress = false;
+				}
+
+				if (compress) {
+					recordData = s_compressBuffer;
+				}
 			}
 
-			std::string strData = buffer.str();
-			size_t size = strData.size();
+			size_t size = recordData.size();
 
-			if (size <= UINT32_MAX) {
+			if (size < kCompressedRecordFlag) {
 				uint32_t smallSize = static_cast<uint32_t>(size);
-				if (!s_intfc->WriteRecordData(&smallSize, sizeof(smallSize))) {
+				uint32_t header = compress ? (smallSize | kCompressedRecordFlag) : smallSize;
+				if (!s_intfc->WriteRecordData(&header, sizeof(header))) {
 					logger::warn("Failed to write {} record size. Co-save might become corrupted.", rcrd);
 					return;
 				}
-				if (!s_intfc->WriteRecordData(strData.data(), smallSize)) {
+				if (!s_intfc->WriteRecordData(recordData.data(), smallSize)) {
 					logger::warn("Failed to write {} record data. Co-save might become corrupted.", rcrd);
+					return;
 				}
 			} else {
 				logger::warn("{} record data is over supported limit. Data will not be saved!", rcrd);
+				return;
 			}
+
+			logger::debug("Saved {} record: {} bytes ({} encoded) in {:.3f}ms.", rcrd, size, record.data.size(), Utility::QueryPerfCounterTime(timer));
 		}
 
-		template <typename T>
-		bool LoadRecord(std::string_view rcrd, T& dataOut)
+		//Reads the current co-save record into memory without decoding it.
+		bool ReadRecord(std::string_view rcrd, EncodedRecord& out)
 		{
-			uint32_t size;
-			if (s_intfc->ReadRecordData(&size, sizeof(size)) != sizeof(size)) {
+			out.data.clear();
+			out.valid = false;
+
+			uint32_t header;
+			if (s_intfc->ReadRecordData(&header, sizeof(header)) != sizeof(header)) {
 				logger::warn("Failed to read {} record size. Data might be corrupted.", rcrd);
 				return false;
 			}
 
-			std::vector<uint8_t> binaryData;
-			binaryData.resize(size);
-			if (s_intfc->ReadRecordData(&binaryData[0], size) != size) {
+			uint32_t size = header & ~kCompressedRecordFlag;
+			out.compressed = (header & kCompressedRecordFlag) != 0;
+			out.data.resize(size);
+			if (size > 0 && s_intfc->ReadRecordData(out.data.data(), size) != size) {
 				logger::warn("Failed to read {} record data. Data might be corrupted.", rcrd);
 				return false;
 			}
 
-			std::istringstream buffer(std::string(binaryData.begin(), binaryData.end()), std::ios::binary);
+			out.valid = true;
+			return true;
+		}
+
+		//Decodes a record read by ReadRecord. Form IDs are resolved through s_intfc, so it must still be set,
+		//but nothing else is read from the co-save, so records can be decoded in parallel.
+		template <typename T>
+		bool DecodeRecord(std::string_view rcrd, const EncodedRecord& record, T& dataOut)
+		{
+			auto timer = Utility::CreatePerfCounter();
+			RecordInputBuffer buffer(record.data);
 
 			try
 			{
-				cereal::BinaryInputArchive archive(buffer);
-				archive(dataOut);
+				std::istream stream(&buffer);
+				if (record.compressed) {
+					zstr::istream zStream(stream);
+					cereal::BinaryInputArchive archive(zStream);
+					archive(dataOut);
+				} else {
+					cereal::BinaryInputArchive archive(stream);
+					archive(dataOut);
+				}
 			}
 			catch (std::exception& e)
 			{
@@ -114,6 +232,7 @@ namespace Serialization
 				return false;
 			}
 
+			logger::debug("Loaded {} record: {} bytes{} in {:.3f}ms.", rcrd, record.data.size(), record.compressed ? " (compressed)" : "", Utility::QueryPerfCounterTime(timer));
 			return true;
 		}
 
@@ -1,50 +1,30 @@
 #pragma once
 #include "General.h"
 
-#define LOAD_PERSISTENT_STATE(_recordId, _recordName, _typePath) \
-case _recordId: \
-{ \
-	auto state = std::make_unique<_typePath::PersistentState>(); \
-	if (Serialization::General::LoadRecord(_recordName, state)) { \
-		_typePath::state.reset(state.release()); \
-	} \
-	break; \
-}
-
-#define LOAD_PERSISTENT_STATE_CL(_recordId, _recordName, _typePath, _statePath) \
-	case _recordId:                                                          \
-		{                                                                    \
-			auto state = std::make_unique<_typePath::PersistentState>();     \
-			if (Serialization::General::LoadRecord(_recordName, state)) {    \
-				_statePath.reset(state.release());                           \
-			}                                                                \
-			break;                                                           \
-		}
-
-#define LOAD_PERSISTENT_STATE_NP(_recordId, _recordName, _typePath, _statePath) \
-	case _recordId:                                                          \
-		{                                                                    \
-			_typePath state;     \
-			if (Serialization::General::LoadRecord(_recordName, state)) {    \
-				_statePath = std::move(state);                                \
-			}                                                                \
-			break;                                                           \
-		}
-
-#define SAVE_PERSISTENT_STATE(_recordId, _ver, _recordName, _statePath) \
-if (!a_intfc->OpenRecord(_recordId, _ver)) { \
-logger::error("Failed to open co-save {} record. Some data will not be saved!", _recordName); \
-} \
-else \
-{ \
-	Serialization::General::SaveRecord(_recordName, _statePath); \
-} \
-	
-
 namespace Serialization
 {
 	constexpr auto DISABLE_SERIALIZATION{ false };
 
+	//A record's data captured under its subsystem's lock, written to the co-save once every lock has been released.
+	struct RecordSnapshot
+	{
+		uint32_t id;
+		uint32_t version;
+		std::string_view name;
+		General::EncodedRecord record;
+	};
+
+	//The persistent states hold polymorphic and move-only data (scenes, timed tasks, package callbacks, face animations)
+	//that can't be copied cheaply, so a snapshot is the state's encoded form, taken while holding only that subsystem's locks.
+	template <typename T, typename... Locks>
+	RecordSnapshot SnapshotRecord(uint32_t id, std::string_view name, const T& state, Locks&... locks)
+	{
+		RecordSnapshot result{ id, 5, name };
+		std::scoped_lock l{ locks... };
+		General::EncodeRecord(name, state, result.record);
+		return result;
+	}
+
 	void SaveCallback(const F4SE::SerializationInterface* a_intfc)
 	{
 		if (DISABLE_SERIALIZATION) {
@@ -56,41 +36,81 @@ namespace Serialization
 		auto tThread = Tasks::TimerThread::GetSingleton();
 		tThread->Stop();
 
-		{
-			std::scoped_lock l{
-				Scene::SceneManager::scenesMapLock,
-				Scene::SceneManager::actorsWalkingLock,
-				tThread->timerLock,
-				FaceAnimation::FaceUpdateHook::loadingAnimsLock,
-				FaceAnimation::FaceUpdateHook::stateLock,
-				BodyAnimation::GraphHook::loadingAnimsLock,
-				BodyAnimation::GraphHook::stateLock,
-				Data::Uid::lock,
-				PackageOverride::lock,
-				Menu::HUDManager::elementsLock,
-				Menu::HUDManager::translationsLock,
-				Scene::OrderedActionQueue::lock,
-				Menu::SceneHUD::lock
-			};
-
-			Serialization::General::s_intfc = a_intfc;
-
-			SAVE_PERSISTENT_STATE('TASK', 5, "task", tThread->state);
-			SAVE_PERSISTENT_STATE('SCNE', 5, "scene", Scene::SceneManager::state);
-			SAVE_PERSISTENT_STATE('EQPT', 5, "equipment", Scene::OrderedActionQueue::state);
-			SAVE_PERSISTENT_STATE('UID', 5, "UID", Data::Uid::state);
-			SAVE_PERSISTENT_STATE('FACE', 5, "face animation", FaceAnimation::FaceUpdateHook::state);
-			SAVE_PERSISTENT_STATE('HUD', 5, "HUD", Menu::HUDManager::state);
-			SAVE_PERSISTENT_STATE('PACK', 5, "package override", PackageOverride::state);
-			SAVE_PERSISTENT_STATE('SHUD', 5, "scene HUD", Menu::SceneHUD::state);
-			SAVE_PERSISTENT_STATE('BODY', 5, "body animation", BodyAnimation::GraphHook::state);
-
-			Serialization::General::s_intfc = nullptr;
+		std::vector<RecordSnapshot> snapshots;
+		snapshots.reserve(9);
+		snapshots.push_back(SnapshotRecord('TASK', "task", tThread->state, tThread->timerLock));
+		snapshots.push_back(SnapshotRecord('SCNE', "scene", Scene::SceneManager::state, Scene::SceneManager::scenesMapLock, Scene::SceneManager::actorsWalkingLock));
+		snapshots.push_back(SnapshotRecord('EQPT', "equipment", Scene::OrderedActionQueue::state, Scene::OrderedActionQueue::lock));
+		snapshots.push_back(SnapshotRecord('UID', "UID", Data::Uid::state, Data::Uid::lock));
+		snapshots.push_back(SnapshotRecord('FACE', "face animation", FaceAnimation::FaceUpdateHook::state, FaceAnimation::FaceUpdateHook::loadingAnimsLock, FaceAnimation::FaceUpdateHook::stateLock));
+		snapshots.push_back(SnapshotRecord('HUD', "HUD", Menu::HUDManager::state, Menu::HUDManager::elementsLock, Menu::HUDManager::translationsLock));
+		snapshots.push_back(SnapshotRecord('PACK', "package override", PackageOverride::state, PackageOverride::lock));
+		snapshots.push_back(SnapshotRecord('SHUD', "scene HUD", Menu::SceneHUD::state, Menu::SceneHUD::lock));
+		snapshots.push_back(SnapshotRecord('BODY', "body animation", BodyAnimation::GraphHook::state, BodyAnimation::GraphHook::loadingAnimsLock, BodyAnimation::GraphHook::stateLock));
+
+		tThread->Start();
+		double snapshotTime = Utility::GetPerformanceCounterMS();
+
+		General::s_intfc = a_intfc;
+		General::s_compressRecords = Data::Settings::Values.bCompressCoSave;
+
+		for (const auto& s : snapshots) {
+			if (!s.record.valid) {
+				logger::error("Failed to capture co-save {} record. Some data will not be saved!", s.name);
+				continue;
+			}
+
+			if (!a_intfc->OpenRecord(s.id, s.version)) {
+				logger::error("Failed to open co-save {} record. Some data will not be saved!", s.name);
+				continue;
+			}
+
+			General::WriteRecord(s.name, s.record);
 		}
 
-		logger::info("Finished serialization in {:.3f}ms", Utility::GetPerformanceCounterMS());
+		General::s_intfc = nullptr;
 
-		tThread->Start();
+		double totalTime = Utility::GetPerformanceCounterMS();
+		logger::info("Finished serialization in {:.3f}ms (snapshot: {:.3f}ms, write: {:.3f}ms)", totalTime, snapshotTime, totalTime - snapshotTime);
+	}
+
+	//A record read from the co-save, decoded alongside the others and swapped in once every record has been decoded.
+	struct PendingRecord
+	{
+		std::string_view name;
+		General::EncodedRecord record;
+		std::function<bool(const General::EncodedRecord&)> decode;
+		std::function<void()> commit;
+		std::function<void()> fixup;
+		bool decoded = false;
+	};
+
+	//Decodes into a new state, which replaces the current one under the subsystem's locks when committed.
+	template <typename T, typename... Locks>
+	PendingRecord LoadIntoNewState(std::string_view name, std::unique_ptr<T>& target, Locks&... locks)
+	{
+		auto loaded = std::make_shared<std::unique_ptr<T>>(std::make_unique<T>());
+		PendingRecord result{ name };
+		result.decode = [name, loaded](const General::EncodedRecord& r) {
+			return General::DecodeRecord(name, r, *loaded);
+		};
+		result.commit = [loaded, &target, &locks...]() {
+			std::scoped_lock l{ locks... };
+			target.reset(loaded->release());
+		};
+		return result;
+	}
+
+	//For states that keep their data in static members, which have to be decoded in place under the subsystem's locks.
+	template <typename T, typename... Locks>
+	PendingRecord LoadInPlace(std::string_view name, std::unique_ptr<T>& target, Locks&... locks)
+	{
+		PendingRecord result{ name };
+		result.decode = [name, &target, &locks...](const General::EncodedRecord& r) {
+			std::scoped_lock l{ locks... };
+			return General::DecodeRecord(name, r, target);
+		};
+		return result;
 	}
 
 	void LoadCallback(const F4SE::SerializationInterface* a_intfc)
@@ -104,51 +124,85 @@ namespace Serialization
 		auto tThread = Tasks::TimerThread::GetSingleton();
 		tThread->Stop();
 
-		{
-			std::scoped_lock l{
-				Scene::SceneManager::scenesMapLock,
-				Scene::SceneManager::actorsWalkingLock,
-				tThread->timerLock,
-				FaceAnimation::FaceUpdateHook::loadingAnimsLock,
-				FaceAnimation::FaceUpdateHook::stateLock,
-				BodyAnimation::GraphHook::loadingAnimsLock,
-				BodyAnimation::GraphHook::stateLock,
-				Data::Uid::lock,
-				PackageOverride::lock,
-				Menu::HUDManager::elementsLock,
-				Menu::HUDManager::translationsLock,
-				Scene::OrderedActionQueue::lock,
-				Menu::SceneHUD::lock
-			};
-
-			Serialization::General::s_intfc = a_intfc;
-
-			uint32_t type;
-			uint32_t length;
-			uint32_t version;
-
-			while (a_intfc->GetNextRecordInfo(type, version, length)) {
-				if (version >= 5) {
-					switch (type) {
-						LOAD_PERSISTENT_STATE_CL('TASK', "task", Tasks::TimerThread, tThread->state);
-						LOAD_PERSISTENT_STATE('SCNE', "scene", Scene::SceneManager);
-						LOAD_PERSISTENT_STATE('EQPT', "equipment", Scene::OrderedActionQueue);
-						LOAD_PERSISTENT_STATE('UID', "UID", Data::Uid);
-						LOAD_PERSISTENT_STATE('FACE', "face animation", FaceAnimation::FaceUpdateHook);
-						LOAD_PERSISTENT_STATE('HUD', "HUD", Menu::HUDManager);
-						LOAD_PERSISTENT_STATE('PACK', "package override", PackageOverride);
-						LOAD_PERSISTENT_STATE('SHUD', "scene HUD", Menu::SceneHUD);
-						LOAD_PERSISTENT_STATE('BODY', "body animation", BodyAnimation::GraphHook);
-					}
-				}
+		General::s_intfc = a_intfc;
+
+		std::vector<PendingRecord> records;
+		uint32_t type;
+		uint32_t length;
+		uint32_t version;
+
+		while (a_intfc->GetNextRecordInfo(type, version, length)) {
+			if (version < 5)
+				continue;
+
+			PendingRecord r;
+			switch (type) {
+			case 'TASK':
+				r = LoadIntoNewState("task", tThread->state, tThread->timerLock);
+				break;
+			case 'SCNE':
+				r = LoadIntoNewState("scene", Scene::SceneManager::state, Scene::SceneManager::scenesMapLock, Scene::SceneManager::actorsWalkingLock);
+				break;
+			case 'EQPT':
+				r = LoadIntoNewState("equipment", Scene::OrderedActionQueue::state, Scene::OrderedActionQueue::lock);
+				break;
+			case 'UID':
+				r = LoadIntoNewState("UID", Data::Uid::state, Data::Uid::lock);
+				break;
+			case 'FACE':
+				r = LoadIntoNewState("face animation", FaceAnimation::FaceUpdateHook::state, FaceAnimation::FaceUpdateHook::loadingAnimsLock, FaceAnimation::FaceUpdateHook::stateLock);
+				r.fixup = FaceAnimation::FaceUpdateHook::OnLoad;
+				break;
+			case 'HUD':
+				r = LoadInPlace("HUD", Menu::HUDManager::state, Menu::HUDManager::elementsLock, Menu::HUDManager::translationsLock);
+				break;
+			case 'PACK':
+				r = LoadIntoNewState("package override", PackageOverride::state, PackageOverride::lock);
+				r.fixup = PackageOverride::OnLoad;
+				break;
+			case 'SHUD':
+				r = LoadIntoNewState("scene HUD", Menu::SceneHUD::state, Menu::SceneHUD::lock);
+				break;
+			case 'BODY':
+				r = LoadIntoNewState("body animation", BodyAnimation::GraphHook::state, BodyAnimation::GraphHook::loadingAnimsLock, BodyAnimation::GraphHook::stateLock);
+				r.fixup = BodyAnimation::GraphHook::OnLoad;
+				break;
+			default:
+				continue;
 			}
 
-			Serialization::General::s_intfc = nullptr;
+			if (General::ReadRecord(r.name, r.record)) {
+				records.push_back(std::move(r));
+			}
 		}
 
-		logger::info("Finished deserialization in {:.3f}ms", Utility::GetPerformanceCounterMS());
+		double readTime = Utility::GetPerformanceCounterMS();
+
+		concurrency::parallel_for_each(records.begin(), records.end(), [](PendingRecord& r) {
+			r.decoded = r.decode(r.record);
+			r.record = {};
+		});
+
+		General::s_intfc = nullptr;
+
+		double decodeTime = Utility::GetPerformanceCounterMS();
+
+		for (auto& r : records) {
+			if (r.decoded && r.commit != nullptr) {
+				r.commit();
+			}
+		}
+
+		for (auto& r : records) {
+			if (r.decoded && r.fixup != nullptr) {
+				r.fixup();
+			}
+		}
 
 		tThread->Start();
+
+		double totalTime = Utility::GetPerformanceCounterMS();
+		logger::info("Finished deserialization in {:.3f}ms (read: {:.3f}ms, decode: {:.3f}ms, fixup: {:.3f}ms)", totalTime, readTime, decodeTime - readTime, totalTime - decodeTime);
 	}
 
 	void RevertCallback(const F4SE::SerializationInterface*)
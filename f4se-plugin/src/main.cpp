@@ -57,7 +57,7 @@ namespace
 					logger::info("Ready!");
 
 					g_gameDataReady = true;
-					Data::Events::Send(Data::Events::GAME_DATA_READY);
+					Data::Events::Send<Data::Events::GAME_DATA_READY>();
 				}
 
 				break;